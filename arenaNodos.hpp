@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "estadisticasAVL.hpp"
+
+//Arena que reparte nodos de a bloques grandes y contiguos en vez de un new/delete por nodo.
+//Los nodos borrados se reciclan con una lista de libres, y al destruirla se liberan los bloques
+//enteros, asi el teardown es O(#bloques) y no O(n). De paso los nodos quedan pegados en memoria.
+template <class Nodo>
+class ArenaNodos {
+public:
+    ArenaNodos() : _bloques(nullptr), _usados(NODOS_POR_BLOQUE), _libres(nullptr) {}
+    ~ArenaNodos(){
+        reiniciar();
+    }
+    ArenaNodos(const ArenaNodos&) = delete;
+    ArenaNodos& operator=(const ArenaNodos&) = delete;
+    template <class... Args>
+    Nodo* crear(Args&&... args){
+        AVL_CONTAR(nodosCreados, 1);
+        return new (tomar()) Nodo(std::forward<Args>(args)...);
+    }
+    void liberar(Nodo* nodo){
+        AVL_CONTAR(nodosLiberados, 1);
+        nodo->~Nodo();
+        NodoLibre* libre = reinterpret_cast<NodoLibre*>(nodo);
+        libre->siguiente = _libres;
+        _libres = libre;
+    }
+    //Absorbe los bloques y la lista de libres de otra arena, que queda vacia. Los nodos que otra
+    //repartio siguen validos (los bloques solo cambian de dueno); es lo que permite construir
+    //subarboles en paralelo con una arena por hilo y despues colgarlos todos de un mismo arbol.
+    void fusionar(ArenaNodos& otra){
+        if (otra._bloques != nullptr){
+            //Los lugares sin repartir del bloque de arriba de otra pasan a la lista de libres
+            for (std::size_t i = otra._usados; i < NODOS_POR_BLOQUE; ++i){
+                NodoLibre* libre = reinterpret_cast<NodoLibre*>(otra._bloques->nodos + sizeof(Nodo) * i);
+                libre->siguiente = otra._libres;
+                otra._libres = libre;
+            }
+            Bloque* cola = otra._bloques;
+            while (cola->siguiente != nullptr) cola = cola->siguiente;
+            if (_bloques == nullptr){ //sin bloques propios: el tope de otra ya quedo saldado arriba
+                _bloques = otra._bloques;
+                _usados = NODOS_POR_BLOQUE;
+            }
+            else { //la cadena de otra se mete debajo de nuestro tope, que sigue repartiendo igual
+                cola->siguiente = _bloques->siguiente;
+                _bloques->siguiente = otra._bloques;
+            }
+            otra._bloques = nullptr;
+        }
+        while (otra._libres != nullptr){
+            NodoLibre* libre = otra._libres;
+            otra._libres = libre->siguiente;
+            libre->siguiente = _libres;
+            _libres = libre;
+        }
+        otra._usados = NODOS_POR_BLOQUE;
+    }
+    //Intercambia el contenido con otra arena en O(1) (los nodos repartidos siguen validos,
+    //solo cambian de dueno). Es lo que hace baratos el swap y el move del arbol.
+    void intercambiar(ArenaNodos& otra){
+        std::swap(_bloques, otra._bloques);
+        std::swap(_usados, otra._usados);
+        std::swap(_libres, otra._libres);
+    }
+    //Libera todos los bloques de una y deja la arena como recien construida. Ojo: invalida
+    //cualquier nodo repartido; el dueno tiene que haber corrido los destructores antes si hacia falta.
+    void reiniciar(){
+        while (_bloques != nullptr){
+            Bloque* siguiente = _bloques->siguiente;
+            operator delete(_bloques);
+            _bloques = siguiente;
+        }
+        _usados = NODOS_POR_BLOQUE;
+        _libres = nullptr;
+    }
+private:
+    static const std::size_t NODOS_POR_BLOQUE = 1024;
+    struct Bloque {
+        Bloque* siguiente;
+        alignas(Nodo) unsigned char nodos[sizeof(Nodo) * NODOS_POR_BLOQUE];
+    };
+    struct NodoLibre { NodoLibre* siguiente; };
+    Bloque* _bloques;
+    std::size_t _usados; //Nodos ya repartidos del bloque de arriba de la pila
+    NodoLibre* _libres;
+    Nodo* tomar(){
+        if (_libres != nullptr){
+            Nodo* nodo = reinterpret_cast<Nodo*>(_libres);
+            _libres = _libres->siguiente;
+            return nodo;
+        }
+        if (_usados == NODOS_POR_BLOQUE){
+            Bloque* bloque = static_cast<Bloque*>(operator new(sizeof(Bloque)));
+            bloque->siguiente = _bloques;
+            _bloques = bloque;
+            _usados = 0;
+        }
+        return reinterpret_cast<Nodo*>(_bloques->nodos + sizeof(Nodo) * _usados++);
+    }
+};
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+#include "conjuntoAVL.hpp"
+#include "diccAVL.hpp"
+
+//Microbenchmarks de ConjuntoAVL y DiccionarioAVL: insert/busqueda/borrado/scan con claves
+//uniformes, secuenciales y zipfianas, en varios tamanos. Sin dependencias: un harness casero
+//alcanza para comparar antes/despues de cada cambio, que es lo que nos venia faltando (mas de
+//una "mejora" regresiono los borrados sin que nadie lo viera).
+//
+//Uso:  benchAVL [n1 n2 ...] [--guardar base.txt] [--comparar base.txt]
+//  - sin args corre 1000, 100000 y 1000000 elementos (100M entra, pero paciencia y RAM)
+//  - --guardar escribe los ns/op a un archivo para usar de linea base
+//  - --comparar imprime el delta porcentual contra una linea base guardada
+
+namespace {
+
+double ahora(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+long picoRSSKb(){
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+//Generadores de claves: los tres patrones que vemos en produccion.
+std::vector<std::uint64_t> clavesUniformes(std::size_t n, std::uint64_t semilla){
+    std::mt19937_64 gen(semilla);
+    std::vector<std::uint64_t> claves(n);
+    for (std::size_t i = 0; i < n; ++i) claves[i] = gen();
+    return claves;
+}
+
+std::vector<std::uint64_t> clavesSecuenciales(std::size_t n){
+    std::vector<std::uint64_t> claves(n);
+    for (std::size_t i = 0; i < n; ++i) claves[i] = i;
+    return claves;
+}
+
+//Zipf clasico via inversa aproximada: pocos valores calientes, cola larga. Con s=1 la
+//distribucion queda bien sesgada sin necesitar tablas precalculadas gigantes.
+std::vector<std::uint64_t> clavesZipf(std::size_t n, std::uint64_t semilla){
+    std::mt19937_64 gen(semilla);
+    std::uniform_real_distribution<double> unif(0.0, 1.0);
+    std::vector<std::uint64_t> claves(n);
+    double hn = std::log(static_cast<double>(n) + 1.0);
+    for (std::size_t i = 0; i < n; ++i)
+        claves[i] = static_cast<std::uint64_t>(std::exp(unif(gen) * hn)) - 1;
+    return claves;
+}
+
+struct Resultado {
+    std::string nombre;
+    double nsPorOp;
+};
+
+std::vector<Resultado> resultados;
+
+void reportar(const char* estructura, const char* patron, const char* operacion,
+              std::size_t n, double segundos, std::size_t operaciones){
+    double nsPorOp = segundos * 1e9 / static_cast<double>(operaciones);
+    char nombre[128];
+    std::snprintf(nombre, sizeof(nombre), "%s/%s/%s/%zu", estructura, patron, operacion, n);
+    std::printf("%-48s %10.1f ns/op\n", nombre, nsPorOp);
+    resultados.push_back({nombre, nsPorOp});
+}
+
+//Evita que el compilador borre las busquedas cuyo resultado no se usa
+volatile std::uint64_t sumidero;
+
+void correrConjunto(const char* patron, const std::vector<std::uint64_t>& claves){
+    std::size_t n = claves.size();
+    ConjuntoAVL<std::uint64_t> conjunto;
+    double inicio = ahora();
+    for (std::size_t i = 0; i < n; ++i) conjunto.insertar(claves[i]);
+    reportar("conjunto", patron, "insertar", n, ahora() - inicio, n);
+
+    inicio = ahora();
+    std::uint64_t aciertos = 0;
+    for (std::size_t i = 0; i < n; ++i) aciertos += conjunto.pertenece(claves[i]);
+    reportar("conjunto", patron, "pertenece", n, ahora() - inicio, n);
+    sumidero = aciertos;
+
+    inicio = ahora();
+    std::uint64_t suma = 0;
+    for (ConjuntoAVL<std::uint64_t>::const_iterator it = conjunto.begin(); it != conjunto.end(); ++it)
+        suma += *it;
+    reportar("conjunto", patron, "scan", n, ahora() - inicio, conjunto.cardinal());
+    sumidero = suma;
+
+    inicio = ahora();
+    for (std::size_t i = 0; i < n; ++i) conjunto.borrar(claves[i]);
+    reportar("conjunto", patron, "borrar", n, ahora() - inicio, n);
+}
+
+void correrDicc(const char* patron, const std::vector<std::uint64_t>& claves){
+    std::size_t n = claves.size();
+    DiccionarioAVL<std::uint64_t, std::uint64_t> dicc;
+    double inicio = ahora();
+    for (std::size_t i = 0; i < n; ++i) dicc.definir(claves[i], claves[i] * 2);
+    reportar("dicc", patron, "definir", n, ahora() - inicio, n);
+
+    inicio = ahora();
+    std::uint64_t suma = 0;
+    for (std::size_t i = 0; i < n; ++i) suma += dicc.obtener(claves[i]);
+    reportar("dicc", patron, "obtener", n, ahora() - inicio, n);
+    sumidero = suma;
+
+    inicio = ahora();
+    for (std::size_t i = 0; i < n; ++i) dicc.borrar(claves[i]);
+    reportar("dicc", patron, "borrar", n, ahora() - inicio, n);
+}
+
+void guardarBase(const char* ruta){
+    std::FILE* archivo = std::fopen(ruta, "w");
+    if (archivo == nullptr) return;
+    for (const Resultado& r : resultados)
+        std::fprintf(archivo, "%s %f\n", r.nombre.c_str(), r.nsPorOp);
+    std::fclose(archivo);
+    std::printf("Linea base guardada en %s\n", ruta);
+}
+
+void compararBase(const char* ruta){
+    std::FILE* archivo = std::fopen(ruta, "r");
+    if (archivo == nullptr){
+        std::printf("No pude abrir la linea base %s\n", ruta);
+        return;
+    }
+    std::printf("\nComparacion contra %s (negativo = mas rapido ahora):\n", ruta);
+    char nombre[128];
+    double base;
+    while (std::fscanf(archivo, "%127s %lf", nombre, &base) == 2)
+        for (const Resultado& r : resultados)
+            if (r.nombre == nombre)
+                std::printf("%-48s %+8.1f%%\n", nombre, (r.nsPorOp - base) / base * 100.0);
+    std::fclose(archivo);
+}
+
+} //namespace
+
+int main(int argc, char* argv[]){
+    std::vector<std::size_t> tamanos;
+    const char* rutaGuardar = nullptr;
+    const char* rutaComparar = nullptr;
+    for (int i = 1; i < argc; ++i){
+        if (std::strcmp(argv[i], "--guardar") == 0 && i + 1 < argc) rutaGuardar = argv[++i];
+        else if (std::strcmp(argv[i], "--comparar") == 0 && i + 1 < argc) rutaComparar = argv[++i];
+        else tamanos.push_back(std::strtoull(argv[i], nullptr, 10));
+    }
+    if (tamanos.empty()) tamanos = {1000, 100000, 1000000};
+
+    for (std::size_t n : tamanos){
+        correrConjunto("uniforme", clavesUniformes(n, 42));
+        correrConjunto("secuencial", clavesSecuenciales(n));
+        correrConjunto("zipf", clavesZipf(n, 42));
+        correrDicc("uniforme", clavesUniformes(n, 42));
+        correrDicc("secuencial", clavesSecuenciales(n));
+        correrDicc("zipf", clavesZipf(n, 42));
+    }
+    std::printf("\nPico de RSS: %ld KB\n", picoRSSKb());
+    if (rutaGuardar != nullptr) guardarBase(rutaGuardar);
+    if (rutaComparar != nullptr) compararBase(rutaComparar);
+    return 0;
+}
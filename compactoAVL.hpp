@@ -0,0 +1,258 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include "arenaNodos.hpp"
+
+//Modo compacto: nodos sin puntero padre y con balanceo/altura empaquetados en un byte cada uno
+//(el balanceo vive en [-2,2] y la altura de un AVL nunca pasa de 1.44*log2(n) < 96, sobra con
+//int8). Para ConjuntoAVLCompacto<uint32_t> el nodo baja de 40 a 24 bytes: en un arbol de 40M
+//de nodos son ~640MB menos y bastantes menos lineas de cache por descenso. El costo es que sin
+//padre el rebalanceo no puede subir por punteros: cada operacion guarda el camino de bajada en
+//una pila explicita de enlaces (punteros a los punteros hijo) y rebalancea desandandola. Por lo
+//mismo esta variante no tiene iteradores con siguienteAVL ni printAVL; es para los arboles
+//gigantes donde manda la memoria, el modo comun sigue siendo el default.
+
+//Los punteros van primero para que una clave chica (uint32) no meta relleno de alineacion:
+//con los punteros adelante el nodo de conjunto queda en 16 + clave + 2 bytes redondeados.
+template <class Clave, class Definicion = void>
+class NodoAVLCompacto {
+public:
+    NodoAVLCompacto *izquierda, *derecha;
+    Clave clave;
+    Definicion definicion;
+    std::int8_t balanceo;
+    std::int8_t altura;
+    NodoAVLCompacto(Clave clave, Definicion definicion) : izquierda(nullptr), derecha(nullptr), clave(std::move(clave)), definicion(std::move(definicion)), balanceo(0), altura(0) {}
+};
+
+template <class Clave>
+class NodoAVLCompacto<Clave, void> {
+public:
+    NodoAVLCompacto *izquierda, *derecha;
+    Clave clave;
+    std::int8_t balanceo;
+    std::int8_t altura;
+    explicit NodoAVLCompacto(Clave clave) : izquierda(nullptr), derecha(nullptr), clave(std::move(clave)), balanceo(0), altura(0) {}
+};
+
+//Alcanza de sobra: altura maxima ~1.44*log2(2^64) mas el enlace a la raiz
+const int MAXIMO_CAMINO_COMPACTO = 96;
+
+template <class Nodo>
+int largoCompacto(Nodo* nodo){
+    return nodo == nullptr ? -1 : nodo->altura;
+}
+
+template <class Nodo>
+void definirBalanceoCompacto(Nodo* nodo){
+    int izq = largoCompacto(nodo->izquierda), der = largoCompacto(nodo->derecha);
+    nodo->altura = static_cast<std::int8_t>(1 + (izq > der ? izq : der));
+    nodo->balanceo = static_cast<std::int8_t>(der - izq);
+}
+
+//Las rotaciones operan sobre el enlace (el puntero hijo del padre, o la raiz): al no haber
+//punteros padre el reenganche hacia arriba sale gratis escribiendo *enlace.
+template <class Nodo>
+void rotacionIzquierdaCompacta(Nodo*& enlace){
+    Nodo* nodo = enlace;
+    Nodo* nuevoNodoRaiz = nodo->derecha;
+    nodo->derecha = nuevoNodoRaiz->izquierda;
+    nuevoNodoRaiz->izquierda = nodo;
+    definirBalanceoCompacto(nodo);
+    definirBalanceoCompacto(nuevoNodoRaiz);
+    enlace = nuevoNodoRaiz;
+}
+
+template <class Nodo>
+void rotacionDerechaCompacta(Nodo*& enlace){
+    Nodo* nodo = enlace;
+    Nodo* nuevoNodoRaiz = nodo->izquierda;
+    nodo->izquierda = nuevoNodoRaiz->derecha;
+    nuevoNodoRaiz->derecha = nodo;
+    definirBalanceoCompacto(nodo);
+    definirBalanceoCompacto(nuevoNodoRaiz);
+    enlace = nuevoNodoRaiz;
+}
+
+//Desanda el camino guardado corrigiendo alturas y rotando donde haga falta; corta en el primer
+//nivel cuya altura no cambio, igual que rebalancearAVL pero sobre la pila en vez de los padres.
+template <class Nodo>
+void rebalancearCaminoCompacto(Nodo** camino[], int tope){
+    while (tope > 0){
+        Nodo*& enlace = *camino[--tope];
+        int alturaAntes = enlace->altura;
+        definirBalanceoCompacto(enlace);
+        if (enlace->balanceo == -2){
+            if (largoCompacto(enlace->izquierda->izquierda) >= largoCompacto(enlace->izquierda->derecha))
+                rotacionDerechaCompacta(enlace);
+            else {
+                rotacionIzquierdaCompacta(enlace->izquierda);
+                rotacionDerechaCompacta(enlace);
+            }
+        }
+        else if (enlace->balanceo == 2){
+            if (largoCompacto(enlace->derecha->derecha) >= largoCompacto(enlace->derecha->izquierda))
+                rotacionIzquierdaCompacta(enlace);
+            else {
+                rotacionDerechaCompacta(enlace->derecha);
+                rotacionIzquierdaCompacta(enlace);
+            }
+        }
+        if (enlace->altura == alturaAntes) return; //nada cambia mas arriba
+    }
+}
+
+//Inserta construyendo el nodo con los args extra (la definicion en el caso diccionario).
+//Devuelve false si la clave ya estaba (y no toca nada).
+template <class Nodo, class Clave, class... Args>
+bool insertarCompacto(Nodo*& raiz, ArenaNodos<Nodo>& arena, const Clave& clave, Args&&... args){
+    Nodo** camino[MAXIMO_CAMINO_COMPACTO];
+    int tope = 0;
+    Nodo** enlace = &raiz;
+    while (*enlace != nullptr){
+        camino[tope++] = enlace;
+        if (clave < (*enlace)->clave) enlace = &(*enlace)->izquierda;
+        else if ((*enlace)->clave < clave) enlace = &(*enlace)->derecha;
+        else return false;
+    }
+    *enlace = arena.crear(clave, std::forward<Args>(args)...);
+    rebalancearCaminoCompacto(camino, tope);
+    return true;
+}
+
+template <class Nodo, class Clave>
+Nodo* buscarCompacto(Nodo* nodo, const Clave& clave){
+    while (nodo != nullptr){
+        if (clave < nodo->clave) nodo = nodo->izquierda;
+        else if (nodo->clave < clave) nodo = nodo->derecha;
+        else return nodo;
+    }
+    return nullptr;
+}
+
+template <class Clave, class Definicion>
+void copiarDefinicionCompacta(NodoAVLCompacto<Clave, Definicion>* destino, NodoAVLCompacto<Clave, Definicion>* origen){
+    destino->definicion = std::move(origen->definicion);
+}
+
+template <class Clave>
+void copiarDefinicionCompacta(NodoAVLCompacto<Clave, void>*, NodoAVLCompacto<Clave, void>*){}
+
+//Borrado clasico con pila: si el nodo tiene dos hijos se le copia la clave (y definicion) del
+//predecesor y se borra el predecesor, que tiene a lo sumo un hijo. Devuelve false si no estaba.
+template <class Nodo, class Clave>
+bool borrarCompacto(Nodo*& raiz, ArenaNodos<Nodo>& arena, const Clave& clave){
+    Nodo** camino[MAXIMO_CAMINO_COMPACTO];
+    int tope = 0;
+    Nodo** enlace = &raiz;
+    while (*enlace != nullptr && ((*enlace)->clave < clave || clave < (*enlace)->clave)){
+        camino[tope++] = enlace;
+        enlace = clave < (*enlace)->clave ? &(*enlace)->izquierda : &(*enlace)->derecha;
+    }
+    if (*enlace == nullptr) return false;
+    Nodo* nodoBorrar = *enlace;
+    if (nodoBorrar->izquierda != nullptr && nodoBorrar->derecha != nullptr){
+        //Bajo al predecesor (maximo del subarbol izquierdo) apilando el camino
+        camino[tope++] = enlace;
+        enlace = &nodoBorrar->izquierda;
+        while ((*enlace)->derecha != nullptr){
+            camino[tope++] = enlace;
+            enlace = &(*enlace)->derecha;
+        }
+        nodoBorrar->clave = std::move((*enlace)->clave);
+        copiarDefinicionCompacta(nodoBorrar, *enlace);
+        nodoBorrar = *enlace;
+    }
+    *enlace = nodoBorrar->izquierda != nullptr ? nodoBorrar->izquierda : nodoBorrar->derecha;
+    arena.liberar(nodoBorrar);
+    rebalancearCaminoCompacto(camino, tope);
+    return true;
+}
+
+template <class T>
+class ConjuntoAVLCompacto {
+public:
+    ConjuntoAVLCompacto() : _raiz(nullptr), _cardinal(0) {}
+    ~ConjuntoAVLCompacto(){
+        if (!std::is_trivially_destructible<T>::value) destruir(_raiz);
+    }
+    unsigned int cardinal() const { return _cardinal; }
+    bool pertenece(const T& clave) const { return buscarCompacto(_raiz, clave) != nullptr; }
+    void insertar(const T& clave){
+        if (insertarCompacto(_raiz, _arena, clave)) _cardinal++;
+    }
+    void borrar(const T& clave){
+        if (borrarCompacto(_raiz, _arena, clave)) _cardinal--;
+    }
+    //Pre: cardinal() > 0
+    const T& minimo() const {
+        Nodo* nodo = _raiz;
+        while (nodo->izquierda != nullptr) nodo = nodo->izquierda;
+        return nodo->clave;
+    }
+    const T& maximo() const {
+        Nodo* nodo = _raiz;
+        while (nodo->derecha != nullptr) nodo = nodo->derecha;
+        return nodo->clave;
+    }
+private:
+    typedef NodoAVLCompacto<T> Nodo;
+    Nodo* _raiz;
+    unsigned int _cardinal;
+    ArenaNodos<Nodo> _arena;
+    void destruir(Nodo* raiz){
+        //Mismo truco que en el conjunto comun: recuelgo la izquierda del maximo y avanzo sin pila
+        while (raiz != nullptr){
+            Nodo* siguiente;
+            if (raiz->izquierda != nullptr){
+                Nodo* maximo = raiz->izquierda;
+                while (maximo->derecha != nullptr) maximo = maximo->derecha;
+                maximo->derecha = raiz->derecha;
+                siguiente = raiz->izquierda;
+            }
+            else siguiente = raiz->derecha;
+            _arena.liberar(raiz);
+            raiz = siguiente;
+        }
+    }
+};
+
+template <class K, class V = K>
+class DiccionarioAVLCompacto {
+public:
+    DiccionarioAVLCompacto() : _raiz(nullptr), _cardinal(0) {}
+    ~DiccionarioAVLCompacto(){
+        if (!std::is_trivially_destructible<K>::value || !std::is_trivially_destructible<V>::value)
+            destruir(_raiz);
+    }
+    unsigned int cardinal() const { return _cardinal; }
+    bool definido(const K& clave) const { return buscarCompacto(_raiz, clave) != nullptr; }
+    //Pre: la clave esta definida
+    const V& obtener(const K& clave) const { return buscarCompacto(_raiz, clave)->definicion; }
+    void definir(const K& clave, const V& definicion){
+        if (insertarCompacto(_raiz, _arena, clave, definicion)) _cardinal++;
+        else buscarCompacto(_raiz, clave)->definicion = definicion;
+    }
+    void borrar(const K& clave){
+        if (borrarCompacto(_raiz, _arena, clave)) _cardinal--;
+    }
+private:
+    typedef NodoAVLCompacto<K, V> Nodo;
+    Nodo* _raiz;
+    unsigned int _cardinal;
+    ArenaNodos<Nodo> _arena;
+    void destruir(Nodo* raiz){
+        while (raiz != nullptr){
+            Nodo* siguiente;
+            if (raiz->izquierda != nullptr){
+                Nodo* maximo = raiz->izquierda;
+                while (maximo->derecha != nullptr) maximo = maximo->derecha;
+                maximo->derecha = raiz->derecha;
+                siguiente = raiz->izquierda;
+            }
+            else siguiente = raiz->derecha;
+            _arena.liberar(raiz);
+            raiz = siguiente;
+        }
+    }
+};
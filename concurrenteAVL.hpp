@@ -0,0 +1,81 @@
+#pragma once
+#include <mutex>
+#include <shared_mutex>
+#include "conjuntoAVL.hpp"
+#include "diccAVL.hpp"
+
+//Variantes con lectores concurrentes: las lecturas toman el lock compartido (N lectores en
+//paralelo) y las escrituras el exclusivo. Para cargas ~98% lecturas esto destraba los cores
+//que hoy serializan detras de un mutex global. Es la version conservadora: un esquema RCU/epocas
+//con lectores sin lock pediria repensar los punteros padre que las rotaciones reenganchan
+//(un lector colgado de un nodo rotado veria el arbol a medio coser), asi que eso queda para
+//la variante persistente, no para esta.
+
+template <class T>
+class ConjuntoAVLConcurrente {
+public:
+    unsigned int cardinal() const {
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _conjunto.cardinal();
+    }
+    bool pertenece(const T& clave) const {
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _conjunto.pertenece(clave);
+    }
+    void insertar(const T& clave){
+        std::unique_lock<std::shared_mutex> lock(_candado);
+        _conjunto.insertar(clave);
+    }
+    void borrar(const T& clave){
+        std::unique_lock<std::shared_mutex> lock(_candado);
+        _conjunto.borrar(clave);
+    }
+    T minimo() const { //Por valor: devolver una referencia a un nodo sin tener el lock seria un use-after-free en potencia
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _conjunto.minimo();
+    }
+    T maximo() const {
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _conjunto.maximo();
+    }
+private:
+    mutable std::shared_mutex _candado;
+    ConjuntoAVL<T> _conjunto;
+};
+
+template <class K, class V = K>
+class DiccionarioAVLConcurrente {
+public:
+    unsigned int cardinal() const {
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _dicc.cardinal();
+    }
+    bool definido(const K& clave) const {
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _dicc.definido(clave);
+    }
+    //Pre: la clave esta definida
+    V obtener(const K& clave) const { //Por valor, igual que minimo(): la referencia moriria al soltar el lock
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _dicc.obtener(clave);
+    }
+    void definir(const K& clave, const V& definicion){
+        std::unique_lock<std::shared_mutex> lock(_candado);
+        _dicc.definir(clave, definicion);
+    }
+    void borrar(const K& clave){
+        std::unique_lock<std::shared_mutex> lock(_candado);
+        _dicc.borrar(clave);
+    }
+    K minimo() const {
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _dicc.minimo();
+    }
+    K maximo() const {
+        std::shared_lock<std::shared_mutex> lock(_candado);
+        return _dicc.maximo();
+    }
+private:
+    mutable std::shared_mutex _candado;
+    DiccionarioAVL<K, V> _dicc;
+};
@@ -0,0 +1,190 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "conjuntoAVL.hpp"
+#include "diccAVL.hpp"
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+//Variante "ancha" de la representacion congelada: en vez de una clave por nodo, bloques de 16
+//claves contiguas (64 bytes justos con claves de 32 bits: una linea de cache) en un arbol
+//implicito 17-ario. Un descenso toca ~log17(n) lineas en vez de ~log2(n): para 40M de claves
+//uint32 son ~7 misses por busqueda contra ~26 del arbol de nodos. Adentro del bloque la
+//posicion se calcula con un compare SIMD de las 16 claves de una (AVX2 si esta, sino SSE2,
+//sino un loop escalar que el compilador vectoriza); el bloque esta ordenado, asi que el rank
+//es un popcount de la mascara. Como el congelado comun, es de solo lectura: se arma desde
+//claves ordenadas y el diccionario lleva las definiciones en una columna paralela con la misma
+//permutacion, asi la sonda SIMD no carga ni un byte de definicion.
+//
+//Solo claves enteras: los bloques incompletos se rellenan con el maximo del tipo como
+//centinela (el rank lo trata como "mas grande que todo"), y el caso borde de buscar justo ese
+//valor se resuelve con un flag de si el maximo real esta en el conjunto.
+
+template <class T>
+class ConjuntoAVLCongeladoAncho {
+    static_assert(std::is_integral<T>::value, "la variante ancha rellena con centinela: solo claves enteras");
+public:
+    ConjuntoAVLCongeladoAncho() : _cardinal(0), _bloques(0), _tieneMaximo(false), _minimo(T()), _maximo(T()) {}
+    //Pre: las claves vienen ordenadas y sin repetidos
+    ConjuntoAVLCongeladoAncho(const T* ordenadas, std::size_t n){ construir(ordenadas, n); }
+    std::size_t cardinal() const { return _cardinal; }
+    bool pertenece(const T& clave) const {
+        if (clave == CENTINELA) return _tieneMaximo; //indistinguible del relleno, se guarda aparte
+        std::size_t indice = indiceLowerBound(clave);
+        return indice != NO_ESTA && _claves[indice] == clave;
+    }
+    //Puntero a la primera clave >= clave, o nullptr si no hay
+    const T* lowerBound(const T& clave) const {
+        std::size_t indice = indiceLowerBound(clave);
+        if (indice == NO_ESTA) return nullptr;
+        if (_claves[indice] == CENTINELA && !_tieneMaximo) return nullptr; //era relleno
+        return &_claves[indice];
+    }
+    //Pre: cardinal() > 0
+    const T& minimo() const { return _minimo; }
+    const T& maximo() const { return _maximo; }
+
+protected:
+    static constexpr std::size_t CLAVES_POR_BLOQUE = 16;
+    static constexpr std::size_t NO_ESTA = static_cast<std::size_t>(-1);
+    static constexpr T CENTINELA = std::numeric_limits<T>::max();
+    std::vector<T> _claves; //bloques de 16 ordenados, arbol implicito 17-ario, relleno CENTINELA
+    std::size_t _cardinal;
+    std::size_t _bloques;
+    bool _tieneMaximo;
+    T _minimo, _maximo;
+
+    static std::size_t hijo(std::size_t bloque, std::size_t rango){ return bloque * (CLAVES_POR_BLOQUE + 1) + 1 + rango; }
+
+    void construir(const T* ordenadas, std::size_t n){
+        _cardinal = n;
+        _bloques = (n + CLAVES_POR_BLOQUE - 1) / CLAVES_POR_BLOQUE;
+        _tieneMaximo = n > 0 && ordenadas[n - 1] == CENTINELA;
+        _minimo = n > 0 ? ordenadas[0] : T();
+        _maximo = n > 0 ? ordenadas[n - 1] : T();
+        _claves.assign(_bloques * CLAVES_POR_BLOQUE, CENTINELA);
+        std::size_t siguiente = 0;
+        colocar(ordenadas, n, 0, siguiente);
+    }
+    //In-orden generalizado del arbol 17-ario: hijo j, clave j, hijo j+1... consume las claves
+    //ordenadas y deja cada bloque ordenado (el relleno queda al final de los bloques del borde)
+    void colocar(const T* ordenadas, std::size_t n, std::size_t bloque, std::size_t& siguiente){
+        if (bloque >= _bloques) return;
+        for (std::size_t j = 0; j < CLAVES_POR_BLOQUE; ++j){
+            colocar(ordenadas, n, hijo(bloque, j), siguiente);
+            if (siguiente < n) _claves[bloque * CLAVES_POR_BLOQUE + j] = ordenadas[siguiente++];
+        }
+        colocar(ordenadas, n, hijo(bloque, CLAVES_POR_BLOQUE), siguiente);
+    }
+    //Cantidad de claves del bloque estrictamente menores que clave (0..16). El bloque esta
+    //ordenado, asi que la mascara del compare es contigua y el rank es su popcount.
+    static unsigned rangoEnBloque(const T* bloque, const T& clave){
+#if defined(__AVX2__)
+        if constexpr (sizeof(T) == 4){
+            //Flip del bit de signo para comparar unsigned con el cmpgt con signo de x86
+            const __m256i vuelta = _mm256_set1_epi32(std::is_signed<T>::value ? 0 : static_cast<int>(0x80000000u));
+            const __m256i sonda = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(clave)), vuelta);
+            __m256i bajas = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bloque)), vuelta);
+            __m256i altas = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bloque + 8)), vuelta);
+            unsigned mascara = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(sonda, bajas))))
+                             | (static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(sonda, altas)))) << 8);
+            return static_cast<unsigned>(__builtin_popcount(mascara));
+        }
+#elif defined(__SSE2__)
+        if constexpr (sizeof(T) == 4){
+            const __m128i vuelta = _mm_set1_epi32(std::is_signed<T>::value ? 0 : static_cast<int>(0x80000000u));
+            const __m128i sonda = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(clave)), vuelta);
+            unsigned mascara = 0;
+            for (std::size_t j = 0; j < CLAVES_POR_BLOQUE; j += 4){
+                __m128i datos = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bloque + j)), vuelta);
+                mascara |= static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(sonda, datos)))) << j;
+            }
+            return static_cast<unsigned>(__builtin_popcount(mascara));
+        }
+#endif
+        //Fallback escalar, branchless: con -O2 el compilador lo vectoriza solo para otros anchos
+        unsigned rango = 0;
+        for (std::size_t j = 0; j < CLAVES_POR_BLOQUE; ++j)
+            rango += bloque[j] < clave;
+        return rango;
+    }
+    //Indice (en _claves) de la primera clave >= clave, o NO_ESTA. El candidato solo se pisa
+    //con un valor estrictamente menor: asi un empate contra el relleno (ambos CENTINELA) no
+    //desplaza al maximo real ya encontrado.
+    std::size_t indiceLowerBound(const T& clave) const {
+        std::size_t bloque = 0;
+        std::size_t candidato = NO_ESTA;
+        while (bloque < _bloques){
+            const T* claves = &_claves[bloque * CLAVES_POR_BLOQUE];
+            unsigned rango = rangoEnBloque(claves, clave);
+            if (rango < CLAVES_POR_BLOQUE &&
+                (candidato == NO_ESTA || claves[rango] < _claves[candidato]))
+                candidato = bloque * CLAVES_POR_BLOQUE + rango;
+            bloque = hijo(bloque, rango);
+            if (bloque < _bloques) __builtin_prefetch(&_claves[bloque * CLAVES_POR_BLOQUE]);
+        }
+        return candidato;
+    }
+};
+
+template <class K, class V = K>
+class DiccionarioAVLCongeladoAncho : public ConjuntoAVLCongeladoAncho<K> {
+public:
+    DiccionarioAVLCongeladoAncho() : _definicionMaximo() {}
+    //Pre: claves ordenadas y sin repetidos, definiciones[i] corresponde a claves[i]
+    DiccionarioAVLCongeladoAncho(const K* claves, const V* definiciones, std::size_t n) : _definicionMaximo() {
+        this->construir(claves, n);
+        //Misma permutacion por bloques que las claves: el indice de la busqueda sirve directo
+        _definiciones.resize(this->_claves.size());
+        std::size_t siguiente = 0;
+        colocarDefiniciones(definiciones, n, 0, siguiente);
+        if (this->_tieneMaximo) _definicionMaximo = definiciones[n - 1];
+    }
+    bool definido(const K& clave) const { return this->pertenece(clave); }
+    //Pre: la clave esta definida
+    const V& obtener(const K& clave) const {
+        //Mismo caso borde que pertenece: contra el relleno el indice puede caer en un slot de
+        //CENTINELA que no es la clave real, asi que la definicion del maximo se guarda aparte
+        if (clave == this->CENTINELA) return _definicionMaximo;
+        return _definiciones[this->indiceLowerBound(clave)];
+    }
+
+private:
+    std::vector<V> _definiciones;
+    V _definicionMaximo; //definicion de CENTINELA si esta definido como clave real
+
+    void colocarDefiniciones(const V* definiciones, std::size_t n, std::size_t bloque, std::size_t& siguiente){
+        if (bloque >= this->_bloques) return;
+        for (std::size_t j = 0; j < this->CLAVES_POR_BLOQUE; ++j){
+            colocarDefiniciones(definiciones, n, this->hijo(bloque, j), siguiente);
+            if (siguiente < n) _definiciones[bloque * this->CLAVES_POR_BLOQUE + j] = definiciones[siguiente++];
+        }
+        colocarDefiniciones(definiciones, n, this->hijo(bloque, this->CLAVES_POR_BLOQUE), siguiente);
+    }
+};
+
+//Congelan un arbol vivo copiando su in-orden, igual que congelarAVL del congelado comun
+template <class T, class NodoT>
+ConjuntoAVLCongeladoAncho<T> congelarAVLAncho(const ConjuntoAVL<T, NodoT>& conjunto){
+    std::vector<T> ordenadas;
+    ordenadas.reserve(conjunto.cardinal());
+    for (typename ConjuntoAVL<T, NodoT>::const_iterator it = conjunto.begin(); it != conjunto.end(); ++it)
+        ordenadas.push_back(*it);
+    return ConjuntoAVLCongeladoAncho<T>(ordenadas.data(), ordenadas.size());
+}
+
+template <class K, class V>
+DiccionarioAVLCongeladoAncho<K, V> congelarAVLAncho(const DiccionarioAVL<K, V>& dicc){
+    std::vector<K> claves;
+    std::vector<V> definiciones;
+    claves.reserve(dicc.cardinal());
+    definiciones.reserve(dicc.cardinal());
+    for (typename DiccionarioAVL<K, V>::const_iterator it = dicc.begin(); it != dicc.end(); ++it){
+        claves.push_back(it.clave());
+        definiciones.push_back(it.definicion());
+    }
+    return DiccionarioAVLCongeladoAncho<K, V>(claves.data(), definiciones.data(), claves.size());
+}
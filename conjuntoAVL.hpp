@@ -0,0 +1,863 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "arenaNodos.hpp"
+#include "nucleoAVL.hpp"
+
+//Conjunto sobre un arbol AVL. Antes vivia arriba del main() en conjuntoAVL.cpp y habia que
+//copiarlo para usarlo; ahora es header puro y el nucleo (nodo + rotaciones) esta en nucleoAVL.hpp
+//compartido con el diccionario.
+
+//Los printsAVL los saque de una pagina que no se donde, pero no es mio :(
+//El tipo de nodo es parametrizable para los aumentos opcionales (ej: NodoAVLCuenta en rankAVL.hpp);
+//con el default no cambia nada.
+template <class T, class NodoT = NodoAVL<T>>
+class ConjuntoAVL {
+public:
+    //Iterador constante en in-orden sobre los punteros padre: recorrer todo el conjunto no
+    //aloca nada y cada ++ es O(1) amortizado, asi los scans ordenados no necesitan copiar claves.
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+        const_iterator() : _nodo(nullptr) {}
+        const T& operator*() const { return _nodo->clave; }
+        const T* operator->() const { return &_nodo->clave; }
+        const_iterator& operator++(){ _nodo = siguienteAVL(_nodo); return *this; }
+        const_iterator operator++(int){ const_iterator copia = *this; ++(*this); return copia; }
+        bool operator==(const const_iterator& otro) const { return _nodo == otro._nodo; }
+        bool operator!=(const const_iterator& otro) const { return _nodo != otro._nodo; }
+    private:
+        friend class ConjuntoAVL<T, NodoT>;
+        explicit const_iterator(const NodoT* nodo) : _nodo(nodo) {}
+        const NodoT* _nodo;
+    };
+
+    ConjuntoAVL();
+    ConjuntoAVL(const T* ordenadas, std::size_t n); //Carga masiva desde claves ordenadas, O(n) y sin rotaciones
+    ConjuntoAVL(const T* ordenadas, std::size_t n, unsigned hilos); //Idem pero repartiendo los subarboles entre hilos
+    //Semantica de valor: la copia clona el arbol entero en O(n) (misma forma, nodos contiguos
+    //de la arena propia) y el move roba raiz, cardinal y arena en O(1). Antes el copy ctor
+    //generado compartia _raiz entre los dos arboles y el doble free era cuestion de tiempo.
+    ConjuntoAVL(const ConjuntoAVL& otro);
+    ConjuntoAVL(ConjuntoAVL&& otro) noexcept;
+    ConjuntoAVL& operator=(ConjuntoAVL otro) noexcept { intercambiar(otro); return *this; } //copy-and-swap: cubre copia y movimiento
+    void intercambiar(ConjuntoAVL& otro) noexcept;
+    ~ConjuntoAVL();
+    unsigned int cardinal() const;
+    //Las rutas de busqueda y borrado se templetean sobre el tipo de la sonda (estilo
+    //is_transparent): alcanza con que Sonda y T se comparen entre si con <, asi buscar un
+    //std::string con un string_view o un char* no construye el string temporal (un malloc/free
+    //por consulta que en el gateway era plata). Las escrituras siguen tomando T, obvio.
+    template <class Sonda>
+    bool pertenece(const Sonda& clave) const;
+    void perteneceLote(const T* claves, std::size_t n, bool* resultados) const; //Busquedas entrelazadas con prefetch
+    void insertar(const T& clave);
+    template <class Sonda>
+    void borrar(const Sonda& clave);
+    void insertarLote(const std::vector<T>& lote); //Alta en tanda: comparte el trabajo entre claves vecinas
+    void borrarLote(const std::vector<T>& lote);
+    //Algebra de conjuntos contra otro arbol, en el lugar: una mezcla de los dos in-ordenes y
+    //una reconstruccion O(n) balanceada desde la arena propia, en vez del loop de
+    //pertenece()+insertar() que pagaba un descenso por clave (el merge nocturno de 64 shards).
+    void unir(const ConjuntoAVL& otro);
+    void intersecar(const ConjuntoAVL& otro);
+    void diferencia(const ConjuntoAVL& otro); //Quedan las claves propias que no estan en otro
+    const T& minimo() const;
+    const T& maximo() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    template <class Sonda>
+    const_iterator lower_bound(const Sonda& clave) const; //Primer elemento >= clave
+    template <class Sonda>
+    const_iterator upper_bound(const Sonda& clave) const; //Primer elemento > clave
+    std::size_t cuantosEnRango(const T& desde, const T& hasta) const; //Cantidad de claves en [desde, hasta]
+    //Aplica visita(clave) a cada clave en [desde, hasta], en orden. Solo baja a los subarboles
+    //que tocan el rango: O(log n + k) con k resultados, nada de recorrer el arbol entero.
+    template <class Visita>
+    void porRango(const T& desde, const T& hasta, Visita&& visita) const { porRangoDesde(_raiz, desde, hasta, visita); }
+    //Exportes para consumo de maquinas (los dumps de ops usaban printAVL y tardaban minutos de
+    //puro I/O de terminal): toVector llena el vector del que llama con el in-orden, una sola
+    //reserve y cero streams; porNiveles recorre en anchura con visita(clave, nivel) para
+    //analisis de estructura.
+    void toVector(std::vector<T>& salida) const;
+    template <class Visita>
+    void porNiveles(Visita&& visita) const;
+    void printAVL();
+    //Vacia el arbol repartiendo los destructores de los subarboles de arriba entre hilos y
+    //liberando los bloques de la arena de una (para los restarts: el teardown nodo a nodo en un
+    //solo core dominaba la ventana de deploy). El arbol queda vacio y usable.
+    void vaciarParalelo(unsigned hilos);
+    bool verificarAVL() const; //Chequeo de invariantes para tests/bench: orden, alturas, balanceo, padres y cuentas
+#ifdef AVL_ESTADISTICAS
+    const EstadisticasAVL& estadisticas() const { return _estadisticas; }
+    void reiniciarEstadisticas(){ _estadisticas = EstadisticasAVL(); }
+#endif
+
+protected: //Funciones necesarias para el funcionamiento del AVL pero no para el uso de conjuntos (protected para los aumentos)
+    typedef NodoT Nodo;
+    Nodo* _raiz;
+    unsigned int _cardinal;
+    ArenaNodos<Nodo> _arena;
+#ifdef AVL_ESTADISTICAS
+    mutable EstadisticasAVL _estadisticas;
+#endif
+    void destruir(Nodo* raiz);
+    void rebalancear(Nodo* nodo);
+    //Devuelven el nodo mas bajo realmente tocado (de ahi para arriba hay que recorregir
+    //alturas), o nullptr si el arbol quedo vacio. borrar() rebalancea una sola vez desde ahi.
+    Nodo* removerHoja(Nodo *nodoBorrar, Nodo *padreNodo); //Sacados del taller del ABB
+    Nodo* removerConUnHijo(Nodo* nodoBorrar, Nodo *padreNodo);
+    Nodo* removerConDosHijos(Nodo *nodoBorrar);
+    Nodo* construirBalanceado(const T* claves, std::size_t n, Nodo* padre);
+    static Nodo* clonar(ArenaNodos<Nodo>& arena, const Nodo* nodo, Nodo* padre);
+    void reconstruir(const std::vector<T>& ordenadas);
+    template <class Fabrica>
+    void construirParaleloCon(std::size_t n, unsigned hilos, Fabrica& fabrica);
+    template <class Fabrica>
+    static Nodo* construirRango(ArenaNodos<Nodo>& arena, std::size_t desde, std::size_t hasta, Nodo* padre, Fabrica& fabrica);
+    static void destruirSolo(Nodo* raiz);
+    template <class Visita>
+    static void porRangoDesde(Nodo* nodo, const T& desde, const T& hasta, Visita& visita){
+        if (nodo == nullptr) return;
+        if (desde < nodo->clave) porRangoDesde(nodo->izquierda, desde, hasta, visita);
+        if (!(nodo->clave < desde) && !(hasta < nodo->clave)) visita(nodo->clave);
+        if (nodo->clave < hasta) porRangoDesde(nodo->derecha, desde, hasta, visita);
+    }
+    Nodo* maximoDeArbol(Nodo *nodoRaiz);
+    Nodo* predecesorMaximo(Nodo *nodo);
+    void printAVL(Nodo* root, int space);
+};
+/***************************************Defino funciones publicas******************************************/
+
+template <class T, class NodoT>
+ConjuntoAVL<T, NodoT>::ConjuntoAVL() {
+    _raiz= nullptr;
+    _cardinal=0;
+}
+
+//Pre: las claves vienen ordenadas y sin repetidos (tipico restore desde un snapshot en disco).
+//Arma el arbol de abajo hacia arriba partiendo al medio, asi queda perfectamente balanceado sin
+//pasar por insertar(): nada de cascadas de rotaciones y los nodos salen contiguos de la arena.
+template <class T, class NodoT>
+ConjuntoAVL<T, NodoT>::ConjuntoAVL(const T* ordenadas, std::size_t n) {
+    _cardinal = 0;
+    _raiz = construirBalanceado(ordenadas, n, nullptr);
+    _cardinal = static_cast<unsigned int>(n);
+}
+
+//Version paralela de la carga masiva: misma estructura final que la secuencial, pero los
+//subarboles se construyen con una arena por hilo y se fusionan al final.
+template <class T, class NodoT>
+ConjuntoAVL<T, NodoT>::ConjuntoAVL(const T* ordenadas, std::size_t n, unsigned hilos) {
+    _raiz = nullptr;
+    _cardinal = 0;
+    auto fabrica = [ordenadas](ArenaNodos<Nodo>& arena, std::size_t indice, Nodo* padre){
+        return arena.crear(ordenadas[indice], padre);
+    };
+    construirParaleloCon(n, hilos, fabrica);
+}
+
+//Clona copiando la estructura tal cual (alturas, balanceos y cuentas incluidos), sin pasar por
+//insertar(): una pasada O(n), cero rotaciones y los nodos salen contiguos de la arena nueva.
+//Es lo que usa el serving para darle un snapshot propio a cada consulta larga.
+template <class T, class NodoT>
+ConjuntoAVL<T, NodoT>::ConjuntoAVL(const ConjuntoAVL& otro) {
+    _raiz = clonar(_arena, otro._raiz, nullptr);
+    _cardinal = otro._cardinal;
+}
+
+template <class T, class NodoT>
+ConjuntoAVL<T, NodoT>::ConjuntoAVL(ConjuntoAVL&& otro) noexcept {
+    _raiz = otro._raiz;
+    _cardinal = otro._cardinal;
+    _arena.intercambiar(otro._arena); //la nuestra recien nace vacia: otro queda vacio y usable
+    otro._raiz = nullptr;
+    otro._cardinal = 0;
+}
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::intercambiar(ConjuntoAVL& otro) noexcept {
+    std::swap(_raiz, otro._raiz);
+    std::swap(_cardinal, otro._cardinal);
+    _arena.intercambiar(otro._arena);
+}
+
+template <class T, class NodoT>
+void swap(ConjuntoAVL<T, NodoT>& uno, ConjuntoAVL<T, NodoT>& otro) noexcept { uno.intercambiar(otro); }
+
+template <class T, class NodoT>
+ConjuntoAVL<T, NodoT>::~ConjuntoAVL() {
+    //Si el nodo entero (clave y carga) no tiene destructor no hace falta recorrer el arbol:
+    //la arena libera los bloques enteros.
+    if (!std::is_trivially_destructible<Nodo>::value) destruir(_raiz);
+}
+
+template <class T, class NodoT>
+unsigned int ConjuntoAVL<T, NodoT>::cardinal() const {
+    return  _cardinal;
+}
+
+template <class T, class NodoT>
+template <class Sonda>
+bool ConjuntoAVL<T, NodoT>::pertenece(const Sonda& clave) const {
+    AVL_MEDIR(&_estadisticas);
+    AVL_BUSQUEDA_EMPIEZA();
+    if constexpr (std::is_integral_v<T> && std::is_integral_v<Sonda>){
+        //Con claves enteras la comparacion sale gratis y lo que duele es errarle al branch de
+        //izquierda/derecha (50/50 con claves al azar: ~la mitad de los niveles son un flush del
+        //pipeline). Esta version baja siempre hasta una hoja sin cortar en la igualdad: una
+        //sola comparacion por nodo y los dos selects son ternarios sin efectos, que el
+        //compilador vuelve cmov. La igualdad se chequea una unica vez al final contra el
+        //ultimo nodo >= clave (mismo candidato que lower_bound). Pagar los ~1.5 niveles de mas
+        //es mas barato que un misprediction por nivel.
+        const Nodo* nodo = _raiz;
+        std::uintptr_t candidato = 0;
+        while (nodo != nullptr){
+            AVL_CONTAR(comparaciones, 1);
+            AVL_BUSQUEDA_BAJA();
+            //mascara: todos unos si hay que ir a la derecha (gcc deja el ternario con un jmp,
+            //asi que el select se hace a mano con AND/OR, puro ALU)
+            std::uintptr_t mascara = -static_cast<std::uintptr_t>(nodo->clave < clave);
+            candidato = (reinterpret_cast<std::uintptr_t>(nodo) & ~mascara) | (candidato & mascara);
+            nodo = reinterpret_cast<const Nodo*>((reinterpret_cast<std::uintptr_t>(nodo->derecha) & mascara)
+                                               | (reinterpret_cast<std::uintptr_t>(nodo->izquierda) & ~mascara));
+        }
+        AVL_BUSQUEDA_TERMINA();
+        const Nodo* encontrado = reinterpret_cast<const Nodo*>(candidato);
+        return encontrado != nullptr && encontrado->clave == clave;
+    }
+    else {
+        Nodo* nodo = _raiz;
+        while (nodo != nullptr && nodo->clave != clave){
+            AVL_CONTAR(comparaciones, 2); //el != de arriba y el < de abajo
+            AVL_BUSQUEDA_BAJA();
+            (clave < nodo->clave) ? nodo = nodo->izquierda
+                                  : nodo = nodo->derecha;
+        }
+        AVL_BUSQUEDA_TERMINA();
+        return nodo != nullptr && nodo->clave == clave;
+    }
+}
+
+//Cada nivel de un descenso es un miss de cache dependiente del anterior: con altura ~26 la
+//latencia de pertenece() es casi pura espera de memoria. Aca se entrelazan 8 descensos a la
+//vez (software pipelining): mientras un carril espera su linea, los otros comparan, y el
+//prefetch del hijo recien elegido pisa la espera del proximo nivel. Mismos resultados que
+//llamar pertenece() por clave, varias veces mas rapido por core en lotes grandes.
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::perteneceLote(const T* claves, std::size_t n, bool* resultados) const {
+    const std::size_t CARRILES = 8;
+    Nodo* nodos[CARRILES];
+    std::size_t indices[CARRILES];
+    std::size_t activos = 0, proximo = 0;
+    while (activos < CARRILES && proximo < n){
+        nodos[activos] = _raiz;
+        indices[activos] = proximo++;
+        activos++;
+    }
+    while (activos > 0){
+        for (std::size_t c = 0; c < activos; ){
+            Nodo* nodo = nodos[c];
+            if (nodo == nullptr || nodo->clave == claves[indices[c]]){
+                resultados[indices[c]] = (nodo != nullptr);
+                if (proximo < n){ //el carril arranca la proxima clave sin esperar a los demas
+                    nodos[c] = _raiz;
+                    indices[c] = proximo++;
+                    c++;
+                }
+                else {
+                    activos--;
+                    nodos[c] = nodos[activos];
+                    indices[c] = indices[activos];
+                }
+            }
+            else {
+                nodos[c] = claves[indices[c]] < nodo->clave ? nodo->izquierda : nodo->derecha;
+                __builtin_prefetch(nodos[c]);
+                c++;
+            }
+        }
+    }
+}
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::insertar(const T& clave){
+    AVL_MEDIR(&_estadisticas);
+    if (_raiz == nullptr) _raiz = _arena.crear(clave, nullptr);
+    else {
+        Nodo *nodo = _raiz;
+        Nodo *padre;
+        bool agregado = false;
+        while (!agregado) {
+            padre = nodo;
+            bool irIzquierda = clave < nodo->clave;
+            if (nodo->clave == clave) return; //ya estaba: nada que colgar y el cardinal no se toca
+            nodo = irIzquierda ? nodo->izquierda : nodo->derecha;
+            if (nodo==nullptr){
+                irIzquierda ? padre->izquierda = _arena.crear(clave,padre)
+                            : padre->derecha = _arena.crear(clave,padre);
+                agregado = true;
+                ajustarCuentaAVL(padre, 1); //no-op salvo nodos con cuenta
+                rebalancear(padre);
+            }
+        }
+    }
+    _cardinal++;
+}
+
+//Hago el borrado del Nodo, verifico si el arbol existe y luego busco el nodo. Si el elemento esta
+//Entonces borro la clave. Si es la raiz pongo a su hijo como raiz, sino reubico los nodos con
+//el nodo padre y luego rebalanceo el arbol.
+
+template <class T, class NodoT>
+template <class Sonda>
+void ConjuntoAVL<T, NodoT>::borrar(const Sonda& clave){
+    AVL_MEDIR(&_estadisticas);
+    if (_raiz == nullptr) return;
+    Nodo *nodo = _raiz;
+    Nodo *padre = nullptr;
+    Nodo *hijo = _raiz;
+    while(hijo != nullptr && nodo->clave != clave){ //Itero hasta encontrar el nodo con la clave a borrar
+        padre = nodo; nodo = hijo;
+        hijo = clave < nodo->clave ? nodo->izquierda : nodo->derecha;
+    }
+    if (nodo->clave == clave ) {
+        Nodo* desde; //el punto estructural del desenganche, que en el caso de dos hijos NO es padre
+        if (nodo->izquierda== nullptr && nodo -> derecha == nullptr)
+            desde = removerHoja(nodo, padre);
+        else if (nodo->izquierda == nullptr || nodo->derecha == nullptr)
+            desde = removerConUnHijo(nodo,padre);
+        else
+            desde = removerConDosHijos(nodo);
+        _cardinal--;
+        if (desde != nullptr) rebalancear(desde);
+    }
+}
+template <class T, class NodoT>
+const T& ConjuntoAVL<T, NodoT>::minimo() const {
+    Nodo* nodo = _raiz;
+    while (nodo->izquierda != nullptr) nodo=nodo->izquierda;
+    return nodo->clave;
+}
+
+template <class T, class NodoT>
+const T& ConjuntoAVL<T, NodoT>::maximo() const {
+    Nodo* nodo = _raiz;
+    while (nodo->derecha != nullptr) nodo=nodo->derecha;
+    return nodo->clave;
+}
+
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::const_iterator ConjuntoAVL<T, NodoT>::begin() const {
+    if (_raiz == nullptr) return end();
+    return const_iterator(minimoDeAVL(static_cast<const Nodo*>(_raiz)));
+}
+
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::const_iterator ConjuntoAVL<T, NodoT>::end() const {
+    return const_iterator(static_cast<const Nodo*>(nullptr));
+}
+
+//Bajo por el arbol acordandome del ultimo nodo donde dobre a la izquierda: ese es el primer >= clave.
+template <class T, class NodoT>
+template <class Sonda>
+typename ConjuntoAVL<T, NodoT>::const_iterator ConjuntoAVL<T, NodoT>::lower_bound(const Sonda& clave) const {
+    const Nodo* nodo = _raiz;
+    const Nodo* candidato = nullptr;
+    while (nodo != nullptr){
+        if (nodo->clave < clave) nodo = nodo->derecha;
+        else { candidato = nodo; nodo = nodo->izquierda; }
+    }
+    return const_iterator(candidato);
+}
+
+template <class T, class NodoT>
+template <class Sonda>
+typename ConjuntoAVL<T, NodoT>::const_iterator ConjuntoAVL<T, NodoT>::upper_bound(const Sonda& clave) const {
+    const Nodo* nodo = _raiz;
+    const Nodo* candidato = nullptr;
+    while (nodo != nullptr){
+        if (clave < nodo->clave) { candidato = nodo; nodo = nodo->izquierda; }
+        else nodo = nodo->derecha;
+    }
+    return const_iterator(candidato);
+}
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::printAVL()
+{
+    // Pass initial space count as 0
+    printAVL(_raiz, 0);
+}
+
+
+//Los lotes grandes no pagan 100K descensos independientes: ordeno el lote y, si es comparable
+//al arbol (no vale la pena el caso a caso), mezclo el in-orden actual con el lote en un arreglo
+//y reconstruyo con la carga masiva O(n): una sola pasada, cero rotaciones y nodos contiguos.
+//Para lotes chicos contra arboles grandes el caso a caso sigue ganando, asi que hay un umbral.
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::insertarLote(const std::vector<T>& lote){
+    if (lote.empty()) return;
+    std::vector<T> ordenado(lote);
+    std::sort(ordenado.begin(), ordenado.end());
+    ordenado.erase(std::unique(ordenado.begin(), ordenado.end()), ordenado.end());
+    if (ordenado.size() * 4 < cardinal()){
+        for (std::size_t i = 0; i < ordenado.size(); ++i) insertar(ordenado[i]);
+        return;
+    }
+    std::vector<T> unidas;
+    unidas.reserve(cardinal() + ordenado.size());
+    const_iterator it = begin();
+    std::size_t i = 0;
+    while (it != end() && i < ordenado.size()){
+        if (*it < ordenado[i]) { unidas.push_back(*it); ++it; }
+        else if (ordenado[i] < *it) unidas.push_back(ordenado[i++]);
+        else { unidas.push_back(*it); ++it; ++i; } //ya estaba
+    }
+    for (; it != end(); ++it) unidas.push_back(*it);
+    for (; i < ordenado.size(); ++i) unidas.push_back(ordenado[i]);
+    reconstruir(unidas);
+}
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::borrarLote(const std::vector<T>& lote){
+    if (lote.empty() || cardinal() == 0) return;
+    std::vector<T> ordenado(lote);
+    std::sort(ordenado.begin(), ordenado.end());
+    ordenado.erase(std::unique(ordenado.begin(), ordenado.end()), ordenado.end());
+    if (ordenado.size() * 4 < cardinal()){
+        for (std::size_t i = 0; i < ordenado.size(); ++i) borrar(ordenado[i]);
+        return;
+    }
+    std::vector<T> quedan;
+    quedan.reserve(cardinal());
+    std::size_t i = 0;
+    for (const_iterator it = begin(); it != end(); ++it){
+        while (i < ordenado.size() && ordenado[i] < *it) ++i;
+        if (i < ordenado.size() && !(*it < ordenado[i])) ++i; //esta en el lote: afuera
+        else quedan.push_back(*it);
+    }
+    reconstruir(quedan);
+}
+
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::unir(const ConjuntoAVL& otro){
+    if (otro.cardinal() == 0) return;
+    std::vector<T> unidas;
+    unidas.reserve(cardinal() + otro.cardinal());
+    const_iterator mio = begin(), suyo = otro.begin();
+    while (mio != end() && suyo != otro.end()){
+        if (*mio < *suyo) { unidas.push_back(*mio); ++mio; }
+        else if (*suyo < *mio) { unidas.push_back(*suyo); ++suyo; }
+        else { unidas.push_back(*mio); ++mio; ++suyo; }
+    }
+    for (; mio != end(); ++mio) unidas.push_back(*mio);
+    for (; suyo != otro.end(); ++suyo) unidas.push_back(*suyo);
+    reconstruir(unidas);
+}
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::intersecar(const ConjuntoAVL& otro){
+    if (cardinal() == 0) return;
+    std::vector<T> comunes;
+    const_iterator mio = begin(), suyo = otro.begin();
+    while (mio != end() && suyo != otro.end()){
+        if (*mio < *suyo) ++mio;
+        else if (*suyo < *mio) ++suyo;
+        else { comunes.push_back(*mio); ++mio; ++suyo; }
+    }
+    reconstruir(comunes);
+}
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::diferencia(const ConjuntoAVL& otro){
+    if (cardinal() == 0 || otro.cardinal() == 0) return;
+    std::vector<T> quedan;
+    quedan.reserve(cardinal());
+    const_iterator suyo = otro.begin();
+    for (const_iterator mio = begin(); mio != end(); ++mio){
+        while (suyo != otro.end() && *suyo < *mio) ++suyo;
+        if (suyo == otro.end() || *mio < *suyo) quedan.push_back(*mio);
+    }
+    reconstruir(quedan);
+}
+
+
+//Con nodos que traen cuenta (ConjuntoAVLRank) sale en O(log n) con dos descensos; con los nodos
+//comunes cae a caminar de lower_bound hasta pasarse, O(log n + k).
+template <class T, class NodoT>
+std::size_t ConjuntoAVL<T, NodoT>::cuantosEnRango(const T& desde, const T& hasta) const {
+    if (hasta < desde) return 0;
+    if constexpr (TieneCuentaAVL<Nodo>::value){
+        //menoresOIguales(hasta) - menores(desde), cada uno un descenso sumando subarboles enteros
+        std::size_t hastaInclusive = 0, antesDeDesde = 0;
+        for (Nodo* nodo = _raiz; nodo != nullptr;){
+            if (hasta < nodo->clave) nodo = nodo->izquierda;
+            else { hastaInclusive += cuentaAVL(nodo->izquierda) + 1; nodo = nodo->derecha; }
+        }
+        for (Nodo* nodo = _raiz; nodo != nullptr;){
+            if (nodo->clave < desde){ antesDeDesde += cuentaAVL(nodo->izquierda) + 1; nodo = nodo->derecha; }
+            else nodo = nodo->izquierda;
+        }
+        return hastaInclusive - antesDeDesde;
+    }
+    else {
+        std::size_t cuantos = 0;
+        for (const_iterator it = lower_bound(desde); it != end() && !(hasta < *it); ++it) ++cuantos;
+        return cuantos;
+    }
+}
+
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::toVector(std::vector<T>& salida) const {
+    salida.clear();
+    salida.reserve(cardinal());
+    for (const_iterator it = begin(); it != end(); ++it)
+        salida.push_back(*it);
+}
+
+//BFS con dos vectores (nivel actual y proximo), como el reparto de vaciarParalelo: nada de
+//colas con punteros y los nodos de un nivel se visitan en orden de izquierda a derecha.
+template <class T, class NodoT>
+template <class Visita>
+void ConjuntoAVL<T, NodoT>::porNiveles(Visita&& visita) const {
+    if (_raiz == nullptr) return;
+    std::vector<const Nodo*> nivel, proximo;
+    nivel.push_back(_raiz);
+    for (int profundidad = 0; !nivel.empty(); ++profundidad){
+        for (std::size_t i = 0; i < nivel.size(); ++i){
+            const Nodo* nodo = nivel[i];
+            visita(nodo->clave, profundidad);
+            if (nodo->izquierda != nullptr) proximo.push_back(nodo->izquierda);
+            if (nodo->derecha != nullptr) proximo.push_back(nodo->derecha);
+        }
+        nivel.swap(proximo);
+        proximo.clear();
+    }
+}
+
+//Valida todos los invariantes de una: orden in-orden, alturas y balanceos cacheados contra los
+//reales, |balanceo| <= 1, punteros padre bien enganchados y cuentas si el nodo las tiene. Es
+//O(n), pensado para que los tests y el stress del benchmark lo corran cada tantas operaciones,
+//no para produccion.
+template <class T, class NodoT>
+bool ConjuntoAVL<T, NodoT>::verificarAVL() const {
+    struct Chequeo {
+        static int altura(const Nodo* nodo, const Nodo* padreEsperado, std::size_t& nodos, bool& ok){
+            if (nodo == nullptr) return -1;
+            if (nodo->padre != padreEsperado) ok = false;
+            if (nodo->izquierda != nullptr && !(nodo->izquierda->clave < nodo->clave)) ok = false;
+            if (nodo->derecha != nullptr && !(nodo->clave < nodo->derecha->clave)) ok = false;
+            std::size_t nodosIzq = 0, nodosDer = 0;
+            int izq = altura(nodo->izquierda, nodo, nodosIzq, ok);
+            int der = altura(nodo->derecha, nodo, nodosDer, ok);
+            if (nodo->altura != 1 + std::max(izq, der)) ok = false;
+            if (nodo->balanceo != der - izq || nodo->balanceo < -1 || nodo->balanceo > 1) ok = false;
+            if constexpr (TieneCuentaAVL<Nodo>::value)
+                if (nodo->cuenta != 1 + nodosIzq + nodosDer) ok = false;
+            nodos = 1 + nodosIzq + nodosDer;
+            return nodo->altura;
+        }
+    };
+    bool ok = true;
+    std::size_t nodos = 0;
+    Chequeo::altura(_raiz, nullptr, nodos, ok);
+    return ok && nodos == _cardinal;
+}
+
+/***************************************Defino funciones privadas******************************************/
+
+//Version iterativa y sin pila auxiliar: antes de liberar cada nodo le cuelgo su subarbol
+//izquierdo a la derecha del maximo de ese subarbol (estilo Morris), asi todo queda en una
+//lista hacia la derecha y no hay recursion que pueda volar la pila en arboles grandes.
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::destruir(Nodo *raiz) {
+    Nodo* nodo = raiz;
+    while (nodo != nullptr){
+        if (nodo->izquierda != nullptr){
+            Nodo* maximoIzq = nodo->izquierda;
+            while (maximoIzq->derecha != nullptr) maximoIzq = maximoIzq->derecha;
+            maximoIzq->derecha = nodo->derecha;
+            nodo->derecha = nodo->izquierda;
+            nodo->izquierda = nullptr;
+        }
+        Nodo* siguiente = nodo->derecha;
+        _arena.liberar(nodo);
+        nodo = siguiente;
+    }
+}
+
+//Tira el arbol actual (los nodos vuelven a la free list de la arena) y lo rearma balanceado
+//desde el arreglo ordenado. Ojo: el que llama tiene que haber copiado las claves ANTES, porque
+//destruir() recuelga los subarboles mientras libera.
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::reconstruir(const std::vector<T>& ordenadas){
+    destruir(_raiz);
+    _raiz = construirBalanceado(ordenadas.data(), ordenadas.size(), nullptr);
+    _cardinal = static_cast<unsigned int>(ordenadas.size());
+}
+
+//Arma el esqueleto de arriba (la "espina") secuencialmente partiendo los rangos al medio y
+//anota un pedazo por hilo; cada pedazo se construye en un std::async con arena propia (la arena
+//no es thread-safe y un lock por nodo mataria el punto), y al final las arenas se fusionan en
+//la del arbol y se corrigen las alturas de la espina de abajo hacia arriba. La fabrica recibe
+//(arena, indice, padre) y devuelve el nodo creado, asi el diccionario reusa esto con sus columnas.
+template <class T, class NodoT>
+template <class Fabrica>
+void ConjuntoAVL<T, NodoT>::construirParaleloCon(std::size_t n, unsigned hilos, Fabrica& fabrica){
+    const std::size_t MINIMO_PARA_REPARTIR = 8192;
+    if (hilos <= 1 || n < MINIMO_PARA_REPARTIR){
+        _raiz = construirRango(_arena, 0, n, nullptr, fabrica);
+        _cardinal = static_cast<unsigned int>(n);
+        return;
+    }
+    struct Pedazo { std::size_t desde, hasta; Nodo* padre; Nodo** enlace; unsigned hilos; };
+    std::vector<Pedazo> pendientes, pedazos;
+    std::vector<Nodo*> espina;
+    pendientes.push_back(Pedazo{0, n, nullptr, &_raiz, hilos});
+    while (!pendientes.empty()){
+        Pedazo pedazo = pendientes.back();
+        pendientes.pop_back();
+        if (pedazo.desde == pedazo.hasta){ *pedazo.enlace = nullptr; continue; }
+        if (pedazo.hilos <= 1 || pedazo.hasta - pedazo.desde < MINIMO_PARA_REPARTIR){
+            pedazos.push_back(pedazo);
+            continue;
+        }
+        std::size_t medio = pedazo.desde + (pedazo.hasta - pedazo.desde) / 2;
+        Nodo* nodo = fabrica(_arena, medio, pedazo.padre);
+        *pedazo.enlace = nodo;
+        espina.push_back(nodo);
+        pendientes.push_back(Pedazo{pedazo.desde, medio, nodo, &nodo->izquierda, pedazo.hilos / 2});
+        pendientes.push_back(Pedazo{medio + 1, pedazo.hasta, nodo, &nodo->derecha, pedazo.hilos - pedazo.hilos / 2});
+    }
+    std::vector<std::future<std::unique_ptr<ArenaNodos<Nodo>>>> futuros;
+    for (const Pedazo& pedazo : pedazos)
+        futuros.push_back(std::async(std::launch::async, [&fabrica, pedazo]{
+            std::unique_ptr<ArenaNodos<Nodo>> arena(new ArenaNodos<Nodo>());
+            *pedazo.enlace = construirRango(*arena, pedazo.desde, pedazo.hasta, pedazo.padre, fabrica);
+            return arena;
+        }));
+    for (std::size_t i = 0; i < futuros.size(); ++i)
+        _arena.fusionar(*futuros[i].get());
+    //La espina quedo anotada padres antes que hijos; al reves las alturas suben bien
+    for (std::size_t i = espina.size(); i > 0; --i)
+        definirBalanceoAVL(espina[i - 1]);
+    _cardinal = static_cast<unsigned int>(n);
+}
+
+template <class T, class NodoT>
+template <class Fabrica>
+typename ConjuntoAVL<T, NodoT>::Nodo* ConjuntoAVL<T, NodoT>::construirRango(ArenaNodos<Nodo>& arena, std::size_t desde, std::size_t hasta, Nodo* padre, Fabrica& fabrica){
+    if (desde == hasta) return nullptr;
+    std::size_t medio = desde + (hasta - desde) / 2;
+    Nodo* nodo = fabrica(arena, medio, padre);
+    nodo->izquierda = construirRango(arena, desde, medio, nodo, fabrica);
+    nodo->derecha = construirRango(arena, medio + 1, hasta, nodo, fabrica);
+    definirBalanceoAVL(nodo);
+    return nodo;
+}
+
+//Como destruir() pero solo corre destructores, sin devolver nodos a la lista de libres: lo usa
+//vaciarParalelo, que despues tira todos los bloques de la arena juntos.
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::destruirSolo(Nodo* raiz){
+    Nodo* nodo = raiz;
+    while (nodo != nullptr){
+        if (nodo->izquierda != nullptr){
+            Nodo* maximoIzq = nodo->izquierda;
+            while (maximoIzq->derecha != nullptr) maximoIzq = maximoIzq->derecha;
+            maximoIzq->derecha = nodo->derecha;
+            nodo->derecha = nodo->izquierda;
+            nodo->izquierda = nullptr;
+        }
+        Nodo* siguiente = nodo->derecha;
+        nodo->~Nodo();
+        nodo = siguiente;
+    }
+}
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::vaciarParalelo(unsigned hilos){
+    if (!std::is_trivially_destructible<Nodo>::value && _raiz != nullptr){
+        //Bajo por niveles destruyendo la punta hasta juntar un subarbol por hilo
+        std::vector<Nodo*> pendientes;
+        pendientes.push_back(_raiz);
+        while (hilos > 1 && pendientes.size() < hilos){
+            std::vector<Nodo*> proximo;
+            for (std::size_t i = 0; i < pendientes.size(); ++i){
+                Nodo* nodo = pendientes[i];
+                if (nodo->izquierda != nullptr) proximo.push_back(nodo->izquierda);
+                if (nodo->derecha != nullptr) proximo.push_back(nodo->derecha);
+                nodo->~Nodo();
+            }
+            pendientes.swap(proximo);
+            if (pendientes.empty()) break;
+        }
+        std::vector<std::future<void>> futuros;
+        for (std::size_t i = 0; i < pendientes.size(); ++i)
+            futuros.push_back(std::async(std::launch::async, destruirSolo, pendientes[i]));
+        for (std::size_t i = 0; i < futuros.size(); ++i)
+            futuros[i].get();
+    }
+    _arena.reiniciar(); //los destructores ya corrieron (o no hacian falta): bloques afuera de una
+    _raiz = nullptr;
+    _cardinal = 0;
+}
+
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::rebalancear(Nodo* nodo){
+    Nodo* arriba = rebalancearAVL(nodo);
+    if (arriba != nullptr) _raiz = arriba; //nullptr: el rebalanceo corto antes de llegar, la raiz quedo igual
+}
+
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::Nodo* ConjuntoAVL<T, NodoT>::removerHoja(Nodo *nodoBorrar, Nodo *padreNodo) {
+    if (padreNodo == nullptr) _raiz= nullptr;
+    else padreNodo->derecha==nodoBorrar ? padreNodo->derecha= nullptr : padreNodo->izquierda= nullptr;
+    ajustarCuentaAVL(padreNodo, -1);
+    _arena.liberar(nodoBorrar);
+    return padreNodo;
+}
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::Nodo* ConjuntoAVL<T, NodoT>::removerConUnHijo(Nodo* nodoBorrar, Nodo *padreNodo) {
+    if (padreNodo == nullptr)//si es la raiz lo que quiero eliminar
+        if (nodoBorrar->derecha== nullptr)  {
+            _raiz=nodoBorrar->izquierda;
+            _raiz->padre = nullptr;
+        }
+        else {
+            _raiz= nodoBorrar->derecha;
+            _raiz->padre = nullptr;
+        }
+    else {
+        if (padreNodo->derecha == nodoBorrar) {
+            nodoBorrar->izquierda == nullptr ? padreNodo->derecha = nodoBorrar->derecha
+                                             : padreNodo->derecha = nodoBorrar->izquierda;
+            padreNodo->derecha->padre = padreNodo;
+        }
+        else {
+            nodoBorrar->izquierda == nullptr ? padreNodo->izquierda = nodoBorrar->derecha
+                                             : padreNodo->izquierda = nodoBorrar->izquierda;
+            padreNodo->izquierda->padre = padreNodo;
+        }
+    }
+    ajustarCuentaAVL(padreNodo, -1);
+    _arena.liberar(nodoBorrar);
+    return padreNodo;
+}
+
+//Con las alturas cacheadas el rebalanceo tiene que arrancar donde realmente se desenlazo el nodo
+//(el predecesor, que puede estar bien abajo del subarbol izquierdo), sino las alturas intermedias quedan viejas.
+//En vez de copiar la carga del predecesor sobre nodoBorrar (un T entero: con claves string era
+//una copia de verdad por borrado), el predecesor se desengancha y se recuelga por punteros en el
+//puesto de nodoBorrar; el que se libera es nodoBorrar y ningun dato se mueve.
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::Nodo* ConjuntoAVL<T, NodoT>::removerConDosHijos(Nodo *nodoBorrar) {
+    Nodo* predMaximo = predecesorMaximo(nodoBorrar);
+    Nodo* padreDeMaximo = predMaximo->padre;
+    Nodo* desde; //el punto estructural del desenganche, de donde arranca el rebalanceo
+    if (nodoBorrar->izquierda == predMaximo){
+        //Hijo directo: el predecesor sube un lugar y conserva su propia izquierda
+        desde = predMaximo;
+    }
+    else {
+        //Desengancho al predecesor de abajo (no tiene derecha) y hereda la izquierda de nodoBorrar
+        padreDeMaximo->derecha = predMaximo->izquierda;
+        if (predMaximo->izquierda != nullptr) predMaximo->izquierda->padre = padreDeMaximo;
+        predMaximo->izquierda = nodoBorrar->izquierda;
+        nodoBorrar->izquierda->padre = predMaximo;
+        desde = padreDeMaximo;
+    }
+    predMaximo->derecha = nodoBorrar->derecha;
+    if (nodoBorrar->derecha != nullptr) nodoBorrar->derecha->padre = predMaximo;
+    predMaximo->padre = nodoBorrar->padre;
+    if (nodoBorrar->padre == nullptr) _raiz = predMaximo;
+    else if (nodoBorrar->padre->izquierda == nodoBorrar) nodoBorrar->padre->izquierda = predMaximo;
+    else nodoBorrar->padre->derecha = predMaximo;
+    //Hereda los metadatos cacheados del puesto que pasa a ocupar; el rebalanceo desde abajo los
+    //recorrige y usa la altura vieja para cortar temprano, igual que antes
+    predMaximo->altura = nodoBorrar->altura;
+    predMaximo->balanceo = nodoBorrar->balanceo;
+    if constexpr (TieneCuentaAVL<Nodo>::value) predMaximo->cuenta = nodoBorrar->cuenta;
+    _arena.liberar(nodoBorrar);
+    ajustarCuentaAVL(desde, -1);
+    return desde;
+}
+
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::Nodo* ConjuntoAVL<T, NodoT>::construirBalanceado(const T* claves, std::size_t n, Nodo* padre){
+    if (n == 0) return nullptr;
+    std::size_t medio = n / 2;
+    Nodo* nodo = _arena.crear(claves[medio], padre);
+    nodo->izquierda = construirBalanceado(claves, medio, nodo);
+    nodo->derecha = construirBalanceado(claves + medio + 1, n - medio - 1, nodo);
+    definirBalanceoAVL(nodo);
+    return nodo;
+}
+
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::Nodo* ConjuntoAVL<T, NodoT>::clonar(ArenaNodos<Nodo>& arena, const Nodo* nodo, Nodo* padre){
+    if (nodo == nullptr) return nullptr;
+    Nodo* copia = crearClonAVL(arena, nodo, padre);
+    copia->balanceo = nodo->balanceo;
+    copia->altura = nodo->altura;
+    if constexpr (TieneCuentaAVL<Nodo>::value) copia->cuenta = nodo->cuenta;
+    copia->izquierda = clonar(arena, nodo->izquierda, copia);
+    copia->derecha = clonar(arena, nodo->derecha, copia);
+    return copia;
+}
+
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::Nodo* ConjuntoAVL<T, NodoT>::maximoDeArbol(Nodo *nodoRaiz) {
+    Nodo* nodo = nodoRaiz;
+    while (nodo->derecha != nullptr) nodo=nodo->derecha;
+    return nodo;
+}
+
+template <class T, class NodoT>
+typename ConjuntoAVL<T, NodoT>::Nodo* ConjuntoAVL<T, NodoT>::predecesorMaximo(Nodo *nodo){
+    Nodo* predMaximo = maximoDeArbol(nodo->izquierda);
+    return predMaximo;
+}
+
+//Recorrido en in-orden inverso (derecha, nodo, izquierda) con pila explicita en vez de
+//recursion, para poder imprimir arboles arbitrariamente profundos sin reventar la pila.
+//Todo se arma en un ostringstream y sale con un unico write: el endl por nodo de antes era un
+//flush por nodo y dominaba el dump (para datos, mejor toVector/porNiveles directo).
+template <class T, class NodoT>
+void ConjuntoAVL<T, NodoT>::printAVL(Nodo* root, int space) {
+    const int COUNT = 10;
+    std::ostringstream salida;
+    std::vector<std::pair<Nodo*, int>> pila;
+    Nodo* nodo = root;
+    while (nodo != nullptr || !pila.empty()){
+        while (nodo != nullptr){
+            space += COUNT;
+            pila.push_back(std::make_pair(nodo, space));
+            nodo = nodo->derecha;
+        }
+        nodo = pila.back().first;
+        space = pila.back().second;
+        pila.pop_back();
+        salida << "\n";
+        for (int i = COUNT; i < space; i++)
+            salida << " ";
+        salida << nodo->clave << "\n";
+        nodo = nodo->izquierda;
+    }
+    std::cout << salida.str();
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+#include "conjuntoAVL.hpp"
+using namespace std;
+
+//Driver interactivo del conjunto, antes pegado abajo de conjuntoAVL.cpp.
+
+template <class T>
+void correrPrograma (ConjuntoAVL<T>& c) {
+    int d;
+    int n;
+    bool cerrarCiclo = false;
+    while(!cerrarCiclo){
+        cout << "Desea saber tamaño del conjunto (0) si n pertenece (1), agregar elemento (2), borrar elemento (3) maximo (4) minimo (5) cerrar(99) otra cosa printAVL" << endl;
+        cin >> d;
+        switch (d) {
+            case 0:
+                cout << "Tamaño del conjunto es " << c.cardinal() << endl; break;
+            case 1: {
+                cout << "N pertenece al conjunto?" << endl; cin >> n; bool p = c.pertenece(n);
+                p ? cout << n << " pertenece" <<endl : cout << n << " no pertenece" << endl;
+                c.printAVL(); break;
+            }
+            case 2: {
+                cout << "Ingrese el elemento a agregar:" << endl; cin >> n; c.insertar(n); c.printAVL(); break;
+            }
+            case 3:
+                cout << "Ingrese el elemento a borrar:" << endl; cin >> n; c.borrar(n); c.printAVL(); break;
+            case 4:
+                cout << "El maximo del conjunto es " << c.maximo() << endl; break;
+            case 5:
+                cout << "El minimo del conjunto es " << c.minimo() << endl; break;
+            case 99:
+                cerrarCiclo = true; break;
+            default:
+                c.printAVL(); break;
+        }
+    }
+}
+
+int main(){
+    ConjuntoAVL<int> c;
+    correrPrograma(c);
+    return 0;
+}
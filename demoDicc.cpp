@@ -0,0 +1,47 @@
+#include <iostream>
+#include "diccAVL.hpp"
+using namespace std;
+
+//Driver interactivo del diccionario, antes pegado abajo de diccAVL.cpp.
+
+template <class T>
+void correrPrograma (DiccionarioAVL<T>& c) {
+    int d;
+    T n;
+    T def;
+    bool cerrarCiclo = false;
+    while(!cerrarCiclo){
+        cout << "Desea saber tamaño del diccionario (0) Ver si la clave esta definida y si si obtener definicion (1), agregar clave y definicion (2), borrar clave (3) maximo (4) minimo (5) cerrar(99) otra cosa printAVL" << endl;
+        cin >> d;
+        switch (d) {
+            case 0:
+                cout << "Tamaño del diccionario es " << c.cardinal() << endl; break;
+            case 1: {
+                cout << "N esta definido en el diccionario?" << endl; cin >> n; bool p = c.definido(n);
+                p ? cout << "Clave " << n << " definida como "<< c.obtener(n) << endl : cout << n << " no esta definido" << endl;
+                c.printAVL(); break;
+            }
+            case 2: {
+                cout << "Ingrese la clave: " << endl; cin >> n;
+                cout << "Ingrese la definicion: "<< endl; cin >> def;
+                c.definir(n,def); c.printAVL(); break;
+            }
+            case 3:
+                cout << "Ingrese el clave a borrar:" << endl; cin >> n; c.borrar(n); c.printAVL(); break;
+            case 4:
+                cout << "El maximo del diccionario es " << c.maximo() << endl; break;
+            case 5:
+                cout << "El minimo del diccionario es " << c.minimo() << endl; break;
+            case 99:
+                cerrarCiclo = true; break;
+            default:
+                c.printAVL(); break;
+        }
+    }
+}
+
+int main(){
+    DiccionarioAVL<int> c;
+    correrPrograma(c);
+    return 0;
+}
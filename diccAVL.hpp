@@ -0,0 +1,640 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "arenaNodos.hpp"
+#include "conjuntoAVL.hpp"
+#include "nucleoAVL.hpp"
+
+//Diccionario sobre el mismo motor AVL que el conjunto: hereda (en privado) de ConjuntoAVL
+//instanciado con NodoAVL<K, V>, asi insertar/borrar/rebalancear/destruir y las rotaciones
+//existen UNA sola vez y cada arreglo de performance llega a los dos a la vez. Aca solo vive
+//lo que de verdad es de diccionario: definir/obtener, el iterador de pares y las variantes
+//de lote que arrastran definiciones. El conjunto instancia NodoAVL<T> (especializacion sin
+//definicion), asi que no paga ni un byte por el campo que no usa.
+//La clave y la definicion son tipos separados (V default K para los usos viejos): mapear ids
+//chicos a structs gordos ya no arrastra el struct por cada comparacion, que solo toca claves.
+
+template <class K, class V = K>
+class DiccionarioAVL : private ConjuntoAVL<K, NodoAVL<K, V>> {
+    typedef ConjuntoAVL<K, NodoAVL<K, V>> Base;
+public:
+    //Iterador constante en in-orden sobre los punteros padre, sin alocar nada. Como el par
+    //clave/definicion no vive junto como un std::pair, operator* arma un par de referencias;
+    //tambien estan clave() y definicion() directos.
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::pair<const K&, const V&> value_type;
+        typedef std::ptrdiff_t difference_type;
+        const_iterator() : _nodo(nullptr) {}
+        std::pair<const K&, const V&> operator*() const { return std::pair<const K&, const V&>(_nodo->clave, _nodo->definicion); }
+        const K& clave() const { return _nodo->clave; }
+        const V& definicion() const { return _nodo->definicion; }
+        const_iterator& operator++(){ _nodo = siguienteAVL(_nodo); return *this; }
+        const_iterator operator++(int){ const_iterator copia = *this; ++(*this); return copia; }
+        bool operator==(const const_iterator& otro) const { return _nodo == otro._nodo; }
+        bool operator!=(const const_iterator& otro) const { return _nodo != otro._nodo; }
+    private:
+        friend class DiccionarioAVL<K, V>;
+        explicit const_iterator(const NodoAVL<K, V>* nodo) : _nodo(nodo) {}
+        const NodoAVL<K, V>* _nodo;
+    };
+
+    DiccionarioAVL() {}
+    DiccionarioAVL(const K* claves, const V* definiciones, std::size_t n); //Carga masiva desde claves ordenadas, O(n) y sin rotaciones
+    DiccionarioAVL(const K* claves, const V* definiciones, std::size_t n, unsigned hilos); //Idem pero repartiendo los subarboles entre hilos
+    //La semantica de valor (clon O(n) en la copia, robo O(1) en el move) viene del motor: los
+    //constructores y el operator= generados llaman a los de la base, que ya clonan bien. Solo
+    //el swap necesita un puente porque afuera nadie puede convertir un diccionario a la base privada.
+    void intercambiar(DiccionarioAVL& otro) noexcept { Base::intercambiar(otro); }
+
+    //Todo lo que no toca definiciones viene derecho del motor
+    using Base::cardinal;
+    using Base::borrar;
+    using Base::minimo;
+    using Base::maximo;
+    using Base::cuantosEnRango;
+    using Base::perteneceLote;
+    using Base::verificarAVL;
+    using Base::vaciarParalelo;
+#ifdef AVL_ESTADISTICAS
+    using Base::estadisticas;
+    using Base::reiniciarEstadisticas;
+#endif
+
+    //Las consultas son transparentes igual que en el motor: la sonda solo se compara, nunca se
+    //materializa como K (buscar un string con un string_view no aloca)
+    template <class Sonda>
+    bool definido(const Sonda& clave) const { return this->pertenece(clave); }
+    template <class Sonda>
+    const V& obtener(const Sonda& clave) const;
+    void definir(const K& clave, const V& definicion);
+    void definir(K&& clave, V&& definicion); //Version por movimiento: cero copias de claves/definiciones gordas
+    template <class... Args>
+    V& definirEmplace(const K& clave, Args&&... args); //Construye la definicion en el lugar con esos args
+    template <class Fabricar>
+    V& obtenerODefinir(const K& clave, Fabricar&& fabricar); //Un solo descenso: devuelve la existente o inserta fabricar()
+    template <class Sonda>
+    const V* obtenerPuntero(const Sonda& clave) const; //nullptr si no esta, sin precondicion (obtener() explota si no esta)
+    template <class Sonda>
+    V* obtenerPuntero(const Sonda& clave);
+    void obtenerLote(const K* claves, std::size_t n, const V** resultados) const; //Busquedas entrelazadas con prefetch; nullptr en el miss
+    void definirLote(const std::vector<std::pair<K, V>>& lote); //Alta en tanda; ante claves repetidas gana la ultima
+    void borrarLote(const std::vector<K>& lote);
+    //Algebra contra otro diccionario, igual que en el motor (mezcla de in-ordenes + rebuild
+    //O(n)); en las claves repetidas de unir decide resolver(clave, propia, ajena), que devuelve
+    //la definicion que queda. Sin resolver gana la propia.
+    template <class Resolver>
+    void unir(const DiccionarioAVL& otro, Resolver&& resolver);
+    void unir(const DiccionarioAVL& otro);
+    void intersecar(const DiccionarioAVL& otro); //Quedan las claves comunes con la definicion propia
+    void diferencia(const DiccionarioAVL& otro); //Quedan las claves propias que no estan en otro
+    const_iterator begin() const;
+    const_iterator end() const;
+    template <class Sonda>
+    const_iterator lower_bound(const Sonda& clave) const; //Primera clave >= clave
+    template <class Sonda>
+    const_iterator upper_bound(const Sonda& clave) const; //Primera clave > clave
+    //Aplica visita(clave, definicion) a cada par con clave en [desde, hasta], en orden; solo baja
+    //a los subarboles que tocan el rango (para las agregaciones por ventana, que copiaban todo)
+    template <class Visita>
+    void porRango(const K& desde, const K& hasta, Visita&& visita) const { porRangoDesde(_raiz, desde, hasta, visita); }
+    //Exportes para maquinas, como en el motor: in-orden a un vector de pares con una sola
+    //reserve, y recorrido por niveles con visita(clave, definicion, nivel)
+    void toVector(std::vector<std::pair<K, V>>& salida) const;
+    template <class Visita>
+    void porNiveles(Visita&& visita) const;
+    void printAVL();
+
+private: //Lo unico propio del diccionario: los caminos que cargan definiciones
+    typedef NodoAVL<K, V> Nodo;
+    using Base::_raiz;
+    using Base::_cardinal;
+    using Base::_arena;
+    using Base::rebalancear;
+    using Base::destruir;
+    template <class CK, class CV>
+    void definirImpl(CK&& clave, CV&& definicion);
+    Nodo* construirBalanceado(const K* claves, const V* definiciones, std::size_t n, Nodo* padre);
+    void reconstruir(const std::vector<K>& claves, const std::vector<V>& definiciones);
+    template <class Visita>
+    static void porRangoDesde(Nodo* nodo, const K& desde, const K& hasta, Visita& visita){
+        if (nodo == nullptr) return;
+        if (desde < nodo->clave) porRangoDesde(nodo->izquierda, desde, hasta, visita);
+        if (!(nodo->clave < desde) && !(hasta < nodo->clave)) visita(nodo->clave, nodo->definicion);
+        if (nodo->clave < hasta) porRangoDesde(nodo->derecha, desde, hasta, visita);
+    }
+    void printAVL(Nodo* root, int space);
+};
+/***************************************Defino funciones publicas******************************************/
+
+template <class K, class V>
+void swap(DiccionarioAVL<K, V>& uno, DiccionarioAVL<K, V>& otro) noexcept { uno.intercambiar(otro); }
+
+
+//Pre: las claves vienen ordenadas y sin repetidos, definiciones[i] corresponde a claves[i].
+//Arma el arbol de abajo hacia arriba partiendo al medio, asi queda perfectamente balanceado sin
+//pasar por definir(): nada de cascadas de rotaciones y los nodos salen contiguos de la arena.
+template <class K, class V>
+DiccionarioAVL<K, V>::DiccionarioAVL(const K* claves, const V* definiciones, std::size_t n) {
+    _raiz = construirBalanceado(claves, definiciones, n, nullptr);
+    _cardinal = static_cast<unsigned int>(n);
+}
+
+template <class K, class V>
+DiccionarioAVL<K, V>::DiccionarioAVL(const K* claves, const V* definiciones, std::size_t n, unsigned hilos) {
+    auto fabrica = [claves, definiciones](ArenaNodos<Nodo>& arena, std::size_t indice, Nodo* padre){
+        return arena.crear(claves[indice], definiciones[indice], padre);
+    };
+    this->construirParaleloCon(n, hilos, fabrica);
+}
+
+//Pre:Debe estar definida la clave
+template<class K, class V>
+template <class Sonda>
+const V& DiccionarioAVL<K, V>::obtener(const Sonda &clave) const {
+    AVL_MEDIR(&this->_estadisticas);
+    AVL_BUSQUEDA_EMPIEZA();
+    if constexpr (std::is_integral_v<K> && std::is_integral_v<Sonda>){
+        //Descenso sin branches para claves enteras (ver pertenece() en el motor); como la
+        //precondicion garantiza que la clave esta, el candidato final es si o si el nodo.
+        const Nodo* nodo = _raiz;
+        std::uintptr_t candidato = 0;
+        while (nodo != nullptr){
+            AVL_CONTAR(comparaciones, 1);
+            AVL_BUSQUEDA_BAJA();
+            //mascara: todos unos si hay que ir a la derecha (gcc deja el ternario con un jmp,
+            //asi que el select se hace a mano con AND/OR, puro ALU)
+            std::uintptr_t mascara = -static_cast<std::uintptr_t>(nodo->clave < clave);
+            candidato = (reinterpret_cast<std::uintptr_t>(nodo) & ~mascara) | (candidato & mascara);
+            nodo = reinterpret_cast<const Nodo*>((reinterpret_cast<std::uintptr_t>(nodo->derecha) & mascara)
+                                               | (reinterpret_cast<std::uintptr_t>(nodo->izquierda) & ~mascara));
+        }
+        AVL_BUSQUEDA_TERMINA();
+        return reinterpret_cast<const Nodo*>(candidato)->definicion;
+    }
+    else {
+        Nodo* nodo = _raiz;
+        while (nodo != nullptr && nodo->clave != clave){
+            AVL_CONTAR(comparaciones, 2);
+            AVL_BUSQUEDA_BAJA();
+            (clave < nodo->clave) ? nodo = nodo->izquierda
+                                  : nodo = nodo->derecha;
+        }
+        AVL_BUSQUEDA_TERMINA();
+        return nodo->definicion;
+    }
+}
+
+template <class K, class V>
+void DiccionarioAVL<K, V>::definir(const K& clave, const V& definicion){
+    definirImpl(clave, definicion);
+}
+
+template <class K, class V>
+void DiccionarioAVL<K, V>::definir(K&& clave, V&& definicion){
+    definirImpl(std::move(clave), std::move(definicion));
+}
+
+//Un solo descenso con forwarding: redefine si la clave existe (sin tocar _cardinal) o cuelga
+//el nodo nuevo donde se corto la busqueda. Antes redefinir tambien incrementaba _cardinal.
+template <class K, class V>
+template <class CK, class CV>
+void DiccionarioAVL<K, V>::definirImpl(CK&& clave, CV&& definicion){
+    AVL_MEDIR(&this->_estadisticas);
+    if (_raiz == nullptr){
+        _raiz = _arena.crear(std::forward<CK>(clave), std::forward<CV>(definicion), nullptr);
+        _cardinal++;
+        return;
+    }
+    Nodo* nodo = _raiz;
+    while (true){
+        if (clave < nodo->clave){
+            if (nodo->izquierda == nullptr){
+                nodo->izquierda = _arena.crear(std::forward<CK>(clave), std::forward<CV>(definicion), nodo);
+                rebalancear(nodo);
+                _cardinal++;
+                return;
+            }
+            nodo = nodo->izquierda;
+        }
+        else if (nodo->clave < clave){
+            if (nodo->derecha == nullptr){
+                nodo->derecha = _arena.crear(std::forward<CK>(clave), std::forward<CV>(definicion), nodo);
+                rebalancear(nodo);
+                _cardinal++;
+                return;
+            }
+            nodo = nodo->derecha;
+        }
+        else {
+            nodo->definicion = std::forward<CV>(definicion);
+            return;
+        }
+    }
+}
+
+template <class K, class V>
+template <class... Args>
+V& DiccionarioAVL<K, V>::definirEmplace(const K& clave, Args&&... args){
+    AVL_MEDIR(&this->_estadisticas);
+    if (_raiz == nullptr){
+        _raiz = _arena.crear(clave, nullptr, std::forward<Args>(args)...);
+        _cardinal++;
+        return _raiz->definicion;
+    }
+    Nodo* nodo = _raiz;
+    while (true){
+        if (clave < nodo->clave){
+            if (nodo->izquierda == nullptr){
+                Nodo* nuevo = _arena.crear(clave, nodo, std::forward<Args>(args)...);
+                nodo->izquierda = nuevo;
+                rebalancear(nodo);
+                _cardinal++;
+                return nuevo->definicion;
+            }
+            nodo = nodo->izquierda;
+        }
+        else if (nodo->clave < clave){
+            if (nodo->derecha == nullptr){
+                Nodo* nuevo = _arena.crear(clave, nodo, std::forward<Args>(args)...);
+                nodo->derecha = nuevo;
+                rebalancear(nodo);
+                _cardinal++;
+                return nuevo->definicion;
+            }
+            nodo = nodo->derecha;
+        }
+        else {
+            nodo->definicion = V(std::forward<Args>(args)...);
+            return nodo->definicion;
+        }
+    }
+}
+
+//El patron de cache "busco; si no esta, computo y guardo" pagaba dos descensos completos
+//(definido + definir). Aca se baja una sola vez: si la clave esta se devuelve su definicion y
+//fabricar ni se evalua; si no, se cuelga el nodo en la hoja donde se corto la busqueda. Con 60%
+//de hits son ~40% menos recorridas de arbol.
+template <class K, class V>
+template <class Fabricar>
+V& DiccionarioAVL<K, V>::obtenerODefinir(const K& clave, Fabricar&& fabricar){
+    AVL_MEDIR(&this->_estadisticas);
+    if (_raiz == nullptr){
+        _raiz = _arena.crear(clave, fabricar(), nullptr);
+        _cardinal++;
+        return _raiz->definicion;
+    }
+    Nodo* nodo = _raiz;
+    while (true){
+        if (clave < nodo->clave){
+            if (nodo->izquierda == nullptr){
+                Nodo* nuevo = _arena.crear(clave, fabricar(), nodo);
+                nodo->izquierda = nuevo;
+                rebalancear(nodo);
+                _cardinal++;
+                return nuevo->definicion;
+            }
+            nodo = nodo->izquierda;
+        }
+        else if (nodo->clave < clave){
+            if (nodo->derecha == nullptr){
+                Nodo* nuevo = _arena.crear(clave, fabricar(), nodo);
+                nodo->derecha = nuevo;
+                rebalancear(nodo);
+                _cardinal++;
+                return nuevo->definicion;
+            }
+            nodo = nodo->derecha;
+        }
+        else return nodo->definicion;
+    }
+}
+
+template <class K, class V>
+template <class Sonda>
+const V* DiccionarioAVL<K, V>::obtenerPuntero(const Sonda& clave) const {
+    AVL_MEDIR(&this->_estadisticas);
+    AVL_BUSQUEDA_EMPIEZA();
+    if constexpr (std::is_integral_v<K> && std::is_integral_v<Sonda>){
+        //Mismo descenso sin branches que pertenece() en el motor (ver el comentario ahi): con
+        //claves enteras se baja hasta una hoja con un compare y dos cmov por nodo, y la
+        //igualdad se chequea una vez al final contra el candidato estilo lower_bound.
+        const Nodo* nodo = _raiz;
+        std::uintptr_t candidato = 0;
+        while (nodo != nullptr){
+            AVL_CONTAR(comparaciones, 1);
+            AVL_BUSQUEDA_BAJA();
+            //mascara: todos unos si hay que ir a la derecha (gcc deja el ternario con un jmp,
+            //asi que el select se hace a mano con AND/OR, puro ALU)
+            std::uintptr_t mascara = -static_cast<std::uintptr_t>(nodo->clave < clave);
+            candidato = (reinterpret_cast<std::uintptr_t>(nodo) & ~mascara) | (candidato & mascara);
+            nodo = reinterpret_cast<const Nodo*>((reinterpret_cast<std::uintptr_t>(nodo->derecha) & mascara)
+                                               | (reinterpret_cast<std::uintptr_t>(nodo->izquierda) & ~mascara));
+        }
+        AVL_BUSQUEDA_TERMINA();
+        const Nodo* encontrado = reinterpret_cast<const Nodo*>(candidato);
+        return encontrado != nullptr && encontrado->clave == clave ? &encontrado->definicion : nullptr;
+    }
+    else {
+        Nodo* nodo = _raiz;
+        while (nodo != nullptr && nodo->clave != clave){
+            AVL_CONTAR(comparaciones, 2);
+            AVL_BUSQUEDA_BAJA();
+            (clave < nodo->clave) ? nodo = nodo->izquierda
+                                  : nodo = nodo->derecha;
+        }
+        AVL_BUSQUEDA_TERMINA();
+        return nodo == nullptr ? nullptr : &nodo->definicion;
+    }
+}
+
+//Version por lotes de obtenerPuntero con la misma tecnica que perteneceLote del motor: 8
+//descensos entrelazados y prefetch del hijo elegido, para que los misses de un carril queden
+//tapados por los compares de los otros. El tier de consultas ya agrupa de a 64 claves por RPC.
+template <class K, class V>
+void DiccionarioAVL<K, V>::obtenerLote(const K* claves, std::size_t n, const V** resultados) const {
+    const std::size_t CARRILES = 8;
+    Nodo* nodos[CARRILES];
+    std::size_t indices[CARRILES];
+    std::size_t activos = 0, proximo = 0;
+    while (activos < CARRILES && proximo < n){
+        nodos[activos] = _raiz;
+        indices[activos] = proximo++;
+        activos++;
+    }
+    while (activos > 0){
+        for (std::size_t c = 0; c < activos; ){
+            Nodo* nodo = nodos[c];
+            if (nodo == nullptr || nodo->clave == claves[indices[c]]){
+                resultados[indices[c]] = (nodo == nullptr ? nullptr : &nodo->definicion);
+                if (proximo < n){
+                    nodos[c] = _raiz;
+                    indices[c] = proximo++;
+                    c++;
+                }
+                else {
+                    activos--;
+                    nodos[c] = nodos[activos];
+                    indices[c] = indices[activos];
+                }
+            }
+            else {
+                nodos[c] = claves[indices[c]] < nodo->clave ? nodo->izquierda : nodo->derecha;
+                __builtin_prefetch(nodos[c]);
+                c++;
+            }
+        }
+    }
+}
+
+template <class K, class V>
+template <class Sonda>
+V* DiccionarioAVL<K, V>::obtenerPuntero(const Sonda& clave){
+    return const_cast<V*>(static_cast<const DiccionarioAVL<K, V>*>(this)->obtenerPuntero(clave));
+}
+
+template <class K, class V>
+template <class Resolver>
+void DiccionarioAVL<K, V>::unir(const DiccionarioAVL& otro, Resolver&& resolver){
+    if (otro.cardinal() == 0) return;
+    std::vector<K> claves;
+    std::vector<V> definiciones;
+    claves.reserve(cardinal() + otro.cardinal());
+    definiciones.reserve(cardinal() + otro.cardinal());
+    const_iterator mio = begin(), suyo = otro.begin();
+    while (mio != end() && suyo != otro.end()){
+        if (mio.clave() < suyo.clave()) { claves.push_back(mio.clave()); definiciones.push_back(mio.definicion()); ++mio; }
+        else if (suyo.clave() < mio.clave()) { claves.push_back(suyo.clave()); definiciones.push_back(suyo.definicion()); ++suyo; }
+        else {
+            claves.push_back(mio.clave());
+            definiciones.push_back(resolver(mio.clave(), mio.definicion(), suyo.definicion()));
+            ++mio; ++suyo;
+        }
+    }
+    for (; mio != end(); ++mio) { claves.push_back(mio.clave()); definiciones.push_back(mio.definicion()); }
+    for (; suyo != otro.end(); ++suyo) { claves.push_back(suyo.clave()); definiciones.push_back(suyo.definicion()); }
+    reconstruir(claves, definiciones);
+}
+
+template <class K, class V>
+void DiccionarioAVL<K, V>::unir(const DiccionarioAVL& otro){
+    unir(otro, [](const K&, const V& propia, const V&){ return propia; });
+}
+
+template <class K, class V>
+void DiccionarioAVL<K, V>::intersecar(const DiccionarioAVL& otro){
+    if (cardinal() == 0) return;
+    std::vector<K> claves;
+    std::vector<V> definiciones;
+    const_iterator mio = begin(), suyo = otro.begin();
+    while (mio != end() && suyo != otro.end()){
+        if (mio.clave() < suyo.clave()) ++mio;
+        else if (suyo.clave() < mio.clave()) ++suyo;
+        else { claves.push_back(mio.clave()); definiciones.push_back(mio.definicion()); ++mio; ++suyo; }
+    }
+    reconstruir(claves, definiciones);
+}
+
+template <class K, class V>
+void DiccionarioAVL<K, V>::diferencia(const DiccionarioAVL& otro){
+    if (cardinal() == 0 || otro.cardinal() == 0) return;
+    std::vector<K> claves;
+    std::vector<V> definiciones;
+    claves.reserve(cardinal());
+    definiciones.reserve(cardinal());
+    const_iterator suyo = otro.begin();
+    for (const_iterator mio = begin(); mio != end(); ++mio){
+        while (suyo != otro.end() && suyo.clave() < mio.clave()) ++suyo;
+        if (suyo == otro.end() || mio.clave() < suyo.clave()){
+            claves.push_back(mio.clave());
+            definiciones.push_back(mio.definicion());
+        }
+    }
+    reconstruir(claves, definiciones);
+}
+
+template <class K, class V>
+typename DiccionarioAVL<K, V>::const_iterator DiccionarioAVL<K, V>::begin() const {
+    if (_raiz == nullptr) return end();
+    return const_iterator(minimoDeAVL(static_cast<const Nodo*>(_raiz)));
+}
+
+template <class K, class V>
+typename DiccionarioAVL<K, V>::const_iterator DiccionarioAVL<K, V>::end() const {
+    return const_iterator(static_cast<const Nodo*>(nullptr));
+}
+
+//Bajo por el arbol acordandome del ultimo nodo donde dobre a la izquierda: ese es el primer >= clave.
+template <class K, class V>
+template <class Sonda>
+typename DiccionarioAVL<K, V>::const_iterator DiccionarioAVL<K, V>::lower_bound(const Sonda& clave) const {
+    const Nodo* nodo = _raiz;
+    const Nodo* candidato = nullptr;
+    while (nodo != nullptr){
+        if (nodo->clave < clave) nodo = nodo->derecha;
+        else { candidato = nodo; nodo = nodo->izquierda; }
+    }
+    return const_iterator(candidato);
+}
+
+template <class K, class V>
+template <class Sonda>
+typename DiccionarioAVL<K, V>::const_iterator DiccionarioAVL<K, V>::upper_bound(const Sonda& clave) const {
+    const Nodo* nodo = _raiz;
+    const Nodo* candidato = nullptr;
+    while (nodo != nullptr){
+        if (clave < nodo->clave) { candidato = nodo; nodo = nodo->izquierda; }
+        else nodo = nodo->derecha;
+    }
+    return const_iterator(candidato);
+}
+
+template <class K, class V>
+void DiccionarioAVL<K, V>::toVector(std::vector<std::pair<K, V>>& salida) const {
+    salida.clear();
+    salida.reserve(cardinal());
+    for (const_iterator it = begin(); it != end(); ++it)
+        salida.push_back(std::pair<K, V>(it.clave(), it.definicion()));
+}
+
+template <class K, class V>
+template <class Visita>
+void DiccionarioAVL<K, V>::porNiveles(Visita&& visita) const {
+    if (_raiz == nullptr) return;
+    std::vector<const Nodo*> nivel, proximo;
+    nivel.push_back(_raiz);
+    for (int profundidad = 0; !nivel.empty(); ++profundidad){
+        for (std::size_t i = 0; i < nivel.size(); ++i){
+            const Nodo* nodo = nivel[i];
+            visita(nodo->clave, nodo->definicion, profundidad);
+            if (nodo->izquierda != nullptr) proximo.push_back(nodo->izquierda);
+            if (nodo->derecha != nullptr) proximo.push_back(nodo->derecha);
+        }
+        nivel.swap(proximo);
+        proximo.clear();
+    }
+}
+
+template<class K, class V>
+void DiccionarioAVL<K, V>::printAVL()
+{
+    // Pass initial space count as 0
+    printAVL(_raiz, 0);
+}
+
+
+//Misma idea que insertarLote del conjunto: para lotes comparables al arbol conviene mezclar el
+//in-orden con el lote ordenado y reconstruir en O(n) antes que pagar un descenso por clave.
+//Dentro del lote gana la ultima aparicion de cada clave, y el lote pisa lo que ya estaba.
+//(No es el insertarLote del motor porque este arrastra definiciones junto con las claves.)
+template <class K, class V>
+void DiccionarioAVL<K, V>::definirLote(const std::vector<std::pair<K, V>>& lote){
+    if (lote.empty()) return;
+    std::vector<std::pair<K, V>> ordenado(lote);
+    std::stable_sort(ordenado.begin(), ordenado.end(),
+                     [](const std::pair<K, V>& a, const std::pair<K, V>& b){ return a.first < b.first; });
+    std::size_t escribo = 0;
+    for (std::size_t i = 0; i < ordenado.size(); ){ //me quedo con la ultima de cada corrida de repetidas
+        std::size_t fin = i;
+        while (fin + 1 < ordenado.size() && !(ordenado[i].first < ordenado[fin + 1].first)) ++fin;
+        ordenado[escribo++] = std::move(ordenado[fin]);
+        i = fin + 1;
+    }
+    ordenado.resize(escribo);
+    if (ordenado.size() * 4 < cardinal()){
+        for (std::size_t i = 0; i < ordenado.size(); ++i) definir(std::move(ordenado[i].first), std::move(ordenado[i].second));
+        return;
+    }
+    std::vector<K> claves;
+    std::vector<V> definiciones;
+    claves.reserve(cardinal() + ordenado.size());
+    definiciones.reserve(cardinal() + ordenado.size());
+    const_iterator it = begin();
+    std::size_t i = 0;
+    while (it != end() && i < ordenado.size()){
+        if (it.clave() < ordenado[i].first){ claves.push_back(it.clave()); definiciones.push_back(it.definicion()); ++it; }
+        else if (ordenado[i].first < it.clave()){ claves.push_back(std::move(ordenado[i].first)); definiciones.push_back(std::move(ordenado[i].second)); ++i; }
+        else { claves.push_back(std::move(ordenado[i].first)); definiciones.push_back(std::move(ordenado[i].second)); ++it; ++i; } //el lote pisa
+    }
+    for (; it != end(); ++it){ claves.push_back(it.clave()); definiciones.push_back(it.definicion()); }
+    for (; i < ordenado.size(); ++i){ claves.push_back(std::move(ordenado[i].first)); definiciones.push_back(std::move(ordenado[i].second)); }
+    reconstruir(claves, definiciones);
+}
+
+template <class K, class V>
+void DiccionarioAVL<K, V>::borrarLote(const std::vector<K>& lote){
+    if (lote.empty() || cardinal() == 0) return;
+    std::vector<K> ordenado(lote);
+    std::sort(ordenado.begin(), ordenado.end());
+    ordenado.erase(std::unique(ordenado.begin(), ordenado.end()), ordenado.end());
+    if (ordenado.size() * 4 < cardinal()){
+        for (std::size_t i = 0; i < ordenado.size(); ++i) borrar(ordenado[i]);
+        return;
+    }
+    std::vector<K> claves;
+    std::vector<V> definiciones;
+    claves.reserve(cardinal());
+    definiciones.reserve(cardinal());
+    std::size_t i = 0;
+    for (const_iterator it = begin(); it != end(); ++it){
+        while (i < ordenado.size() && ordenado[i] < it.clave()) ++i;
+        if (i < ordenado.size() && !(it.clave() < ordenado[i])) ++i; //esta en el lote: afuera
+        else { claves.push_back(it.clave()); definiciones.push_back(it.definicion()); }
+    }
+    reconstruir(claves, definiciones);
+}
+
+/***************************************Defino funciones privadas******************************************/
+
+//Igual que en el conjunto: los nodos vuelven a la arena y el arbol se rearma balanceado en O(n).
+template <class K, class V>
+void DiccionarioAVL<K, V>::reconstruir(const std::vector<K>& claves, const std::vector<V>& definiciones){
+    destruir(_raiz);
+    _raiz = construirBalanceado(claves.data(), definiciones.data(), claves.size(), nullptr);
+    _cardinal = static_cast<unsigned int>(claves.size());
+}
+
+template <class K, class V>
+typename DiccionarioAVL<K, V>::Nodo* DiccionarioAVL<K, V>::construirBalanceado(const K* claves, const V* definiciones, std::size_t n, Nodo* padre){
+    if (n == 0) return nullptr;
+    std::size_t medio = n / 2;
+    Nodo* nodo = _arena.crear(claves[medio], definiciones[medio], padre);
+    nodo->izquierda = construirBalanceado(claves, definiciones, medio, nodo);
+    nodo->derecha = construirBalanceado(claves + medio + 1, definiciones + medio + 1, n - medio - 1, nodo);
+    definirBalanceoAVL(nodo);
+    return nodo;
+}
+
+//Recorrido en in-orden inverso (derecha, nodo, izquierda) con pila explicita en vez de
+//recursion, para poder imprimir arboles arbitrariamente profundos sin reventar la pila.
+//Buffereado en un ostringstream con un unico write al final, como en el motor
+template<class K, class V>
+void DiccionarioAVL<K, V>::printAVL(Nodo* root, int space) {
+    const int COUNT = 10;
+    std::ostringstream salida;
+    std::vector<std::pair<Nodo*, int>> pila;
+    Nodo* nodo = root;
+    while (nodo != nullptr || !pila.empty()){
+        while (nodo != nullptr){
+            space += COUNT;
+            pila.push_back(std::make_pair(nodo, space));
+            nodo = nodo->derecha;
+        }
+        nodo = pila.back().first;
+        space = pila.back().second;
+        pila.pop_back();
+        salida << "\n";
+        for (int i = COUNT; i < space; i++)
+            salida << " ";
+        salida << nodo->clave << ", "<< nodo->definicion << "\n";
+        nodo = nodo->izquierda;
+    }
+    std::cout << salida.str();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+//Capa de estadisticas opcional para los caminos calientes: compilando con -DAVL_ESTADISTICAS
+//cada arbol junta contadores de comparaciones, profundidad de descenso, rotaciones por tipo y
+//altas/bajas de nodos, y los expone con estadisticas() para scrapearlos a metricas. Sin la
+//macro todo esto compila a nada: los hooks son macros vacias y el struct ni existe, asi que el
+//costo en el build normal es exactamente cero.
+//
+//Como las rotaciones y la arena son codigo libre de la clase, el arbol "activa" sus contadores
+//con un puntero thread_local antes de operar (AVL_MEDIR) y los hooks suman a traves de el.
+//Los hilos del build paralelo no heredan el puntero, asi que esa construccion no se cuenta.
+
+#ifdef AVL_ESTADISTICAS
+
+struct EstadisticasAVL {
+    unsigned long long comparaciones = 0; //En busquedas (pertenece/definido/obtener)
+    unsigned long long busquedas = 0;
+    unsigned long long profundidadTotal = 0; //Suma de profundidades: media = total / busquedas
+    unsigned long long profundidadMaxima = 0;
+    unsigned long long rotacionesIzquierda = 0;
+    unsigned long long rotacionesDerecha = 0;
+    unsigned long long rotacionesIzqLuegoDer = 0;
+    unsigned long long rotacionesDerLuegoIzq = 0;
+    unsigned long long nodosCreados = 0;
+    unsigned long long nodosLiberados = 0;
+    double profundidadMedia() const { return busquedas == 0 ? 0.0 : static_cast<double>(profundidadTotal) / static_cast<double>(busquedas); }
+};
+
+inline thread_local EstadisticasAVL* estadisticasActivasAVL = nullptr;
+
+//RAII: activa los contadores del arbol durante la operacion y restaura al salir (por si una
+//operacion de un arbol cae dentro de otra, como el visitor de porRango tocando otro arbol)
+struct MedidorAVL {
+    EstadisticasAVL* anterior;
+    explicit MedidorAVL(EstadisticasAVL* estadisticas) : anterior(estadisticasActivasAVL) { estadisticasActivasAVL = estadisticas; }
+    ~MedidorAVL(){ estadisticasActivasAVL = anterior; }
+};
+
+#define AVL_MEDIR(estadisticas) MedidorAVL _medidorAVL(estadisticas)
+#define AVL_CONTAR(campo, cuanto) do { if (estadisticasActivasAVL != nullptr) estadisticasActivasAVL->campo += (cuanto); } while (0)
+#define AVL_BUSQUEDA_EMPIEZA() unsigned long long _profundidadAVL = 0
+#define AVL_BUSQUEDA_BAJA() (++_profundidadAVL)
+#define AVL_BUSQUEDA_TERMINA() do { \
+        if (estadisticasActivasAVL != nullptr){ \
+            estadisticasActivasAVL->busquedas++; \
+            estadisticasActivasAVL->profundidadTotal += _profundidadAVL; \
+            if (_profundidadAVL > estadisticasActivasAVL->profundidadMaxima) \
+                estadisticasActivasAVL->profundidadMaxima = _profundidadAVL; \
+        } \
+    } while (0)
+
+#else
+
+#define AVL_MEDIR(estadisticas) do {} while (0)
+#define AVL_CONTAR(campo, cuanto) do {} while (0)
+#define AVL_BUSQUEDA_EMPIEZA() do {} while (0)
+#define AVL_BUSQUEDA_BAJA() do {} while (0)
+#define AVL_BUSQUEDA_TERMINA() do {} while (0)
+
+#endif
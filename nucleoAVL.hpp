@@ -0,0 +1,193 @@
+#pragma once
+#include <algorithm>
+#include "estadisticasAVL.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+//Nucleo compartido del AVL: el nodo y las rotaciones/rebalanceo que antes estaban copiados
+//(y ya divergiendo) entre conjuntoAVL y diccAVL. El conjunto usa NodoAVL<T> (sin definicion)
+//y el diccionario NodoAVL<T, T>; todo lo estructural opera generico sobre el nodo.
+
+template <class Clave, class Definicion = void>
+class NodoAVL {
+public:
+    Clave clave;
+    Definicion definicion;
+    int balanceo;
+    int altura; //Altura del subarbol enraizado aca, cacheada para no recorrer el subarbol en cada rebalanceo
+    NodoAVL *izquierda, *derecha, *padre;
+    NodoAVL(Clave clave, Definicion definicion, NodoAVL *p) : clave(std::move(clave)), definicion(std::move(definicion)), balanceo(0), altura(0), padre(p), izquierda(nullptr), derecha(nullptr) {}
+    //Construccion de la definicion en el lugar (para definirEmplace): los args van directo al constructor de Definicion
+    template <class... Args>
+    NodoAVL(Clave clave, NodoAVL *p, Args&&... args) : clave(std::move(clave)), definicion(std::forward<Args>(args)...), balanceo(0), altura(0), padre(p), izquierda(nullptr), derecha(nullptr) {}
+};
+
+//El caso conjunto no paga bytes por una definicion que no existe
+template <class Clave>
+class NodoAVL<Clave, void> {
+public:
+    Clave clave;
+    int balanceo;
+    int altura;
+    NodoAVL *izquierda, *derecha, *padre;
+    NodoAVL(Clave clave, NodoAVL *p) : clave(std::move(clave)), balanceo(0), altura(0), padre(p), izquierda(nullptr), derecha(nullptr) {}
+};
+
+template <class Nodo>
+Nodo* minimoDeAVL(Nodo* nodo){
+    while (nodo->izquierda != nullptr) nodo = nodo->izquierda;
+    return nodo;
+}
+
+//Sucesor en in-orden caminando los punteros padre: bajo al minimo del subarbol derecho,
+//o subo hasta salir de un subarbol derecho. O(1) amortizado sobre un recorrido completo.
+template <class Nodo>
+Nodo* siguienteAVL(Nodo* nodo){
+    if (nodo->derecha != nullptr) return minimoDeAVL(nodo->derecha);
+    Nodo* padre = nodo->padre;
+    while (padre != nullptr && padre->derecha == nodo){
+        nodo = padre;
+        padre = padre->padre;
+    }
+    return padre;
+}
+
+//Crea en la arena un nodo nuevo con la carga de origen colgado de padre (el clon O(n) del
+//arbol copia nodo por nodo sin pasar por insertar). El caso generico lleva solo la clave y el
+//nodo de diccionario suma la definicion.
+template <class Arena, class Nodo>
+Nodo* crearClonAVL(Arena& arena, const Nodo* origen, Nodo* padre){
+    return arena.crear(origen->clave, padre);
+}
+
+template <class Arena, class Clave, class Definicion>
+NodoAVL<Clave, Definicion>* crearClonAVL(Arena& arena, const NodoAVL<Clave, Definicion>* origen, NodoAVL<Clave, Definicion>* padre){
+    return arena.crear(origen->clave, origen->definicion, padre);
+}
+
+template <class Arena, class Clave>
+NodoAVL<Clave, void>* crearClonAVL(Arena& arena, const NodoAVL<Clave, void>* origen, NodoAVL<Clave, void>* padre){
+    return arena.crear(origen->clave, padre);
+}
+
+template <class Nodo>
+int largoAVL(Nodo* nodo){
+    return nodo == nullptr ? -1 : nodo->altura;
+}
+
+//Aumento opcional de estadisticas de orden: si el nodo trae un campo cuenta (tamano del
+//subarbol), el nucleo lo mantiene solo; para los nodos comunes todo esto compila a nada.
+template <class Nodo, class = void>
+struct TieneCuentaAVL : std::false_type {};
+template <class Nodo>
+struct TieneCuentaAVL<Nodo, std::void_t<decltype(std::declval<Nodo&>().cuenta)>> : std::true_type {};
+
+template <class Nodo>
+std::size_t cuentaAVL(Nodo* nodo){
+    if constexpr (TieneCuentaAVL<Nodo>::value)
+        return nodo == nullptr ? 0 : nodo->cuenta;
+    else
+        return 0;
+}
+
+//Suma delta a la cuenta de nodo y de todos sus ancestros. Los inserts/borrados la llaman desde
+//el punto estructural del cambio ANTES de rebalancear, porque el rebalanceo corta temprano por
+//altura pero las cuentas cambian hasta la raiz si o si.
+template <class Nodo>
+void ajustarCuentaAVL(Nodo* nodo, int delta){
+    if constexpr (TieneCuentaAVL<Nodo>::value)
+        for (; nodo != nullptr; nodo = nodo->padre)
+            nodo->cuenta += delta;
+}
+
+//Ademas del balanceo actualizo la altura cacheada a partir de la de los hijos; por eso importa
+//llamarla de abajo hacia arriba (las rotaciones lo hacen: primero el nodo bajado, despues la nueva raiz).
+template <class Nodo>
+void definirBalanceoAVL(Nodo* nodo){
+    nodo->altura = 1 + std::max(largoAVL(nodo->izquierda), largoAVL(nodo->derecha));
+    nodo->balanceo = largoAVL(nodo->derecha) - largoAVL(nodo->izquierda);
+    if constexpr (TieneCuentaAVL<Nodo>::value)
+        nodo->cuenta = 1 + cuentaAVL(nodo->izquierda) + cuentaAVL(nodo->derecha);
+}
+
+template <class Nodo>
+Nodo* rotacionIzquierdaAVL(Nodo* nodo){
+    Nodo *nuevoNodoRaiz = nodo->derecha; //Nuevo nodo raiz del subarbol que se enraizaba en el nodo.
+    nuevoNodoRaiz->padre= nodo->padre;
+    nodo->derecha = nuevoNodoRaiz->izquierda;
+    if (nodo->derecha != nullptr) nodo->derecha->padre = nodo;
+    nuevoNodoRaiz->izquierda=nodo;
+    nodo->padre=nuevoNodoRaiz;
+    if(nuevoNodoRaiz->padre != nullptr)
+        (nuevoNodoRaiz->padre->derecha == nodo) ? nuevoNodoRaiz->padre->derecha = nuevoNodoRaiz
+                                                : nuevoNodoRaiz->padre->izquierda = nuevoNodoRaiz;
+    definirBalanceoAVL(nodo);
+    definirBalanceoAVL(nuevoNodoRaiz);
+    return nuevoNodoRaiz;
+}
+
+template <class Nodo>
+Nodo* rotacionDerechaAVL(Nodo* nodo){
+    Nodo *nuevoNodoRaiz = nodo->izquierda;
+    nuevoNodoRaiz->padre= nodo->padre;
+    nodo->izquierda = nuevoNodoRaiz->derecha;
+    if (nodo->izquierda != nullptr) nodo->izquierda->padre = nodo;
+    nuevoNodoRaiz->derecha=nodo;
+    nodo->padre=nuevoNodoRaiz;
+    if(nuevoNodoRaiz->padre != nullptr)
+        (nuevoNodoRaiz->padre->derecha == nodo) ? nuevoNodoRaiz->padre->derecha = nuevoNodoRaiz
+                                                : nuevoNodoRaiz->padre->izquierda = nuevoNodoRaiz;
+    definirBalanceoAVL(nodo);
+    definirBalanceoAVL(nuevoNodoRaiz);
+    return nuevoNodoRaiz;
+}
+
+template <class Nodo>
+Nodo* rotacionIzqLuegoDerAVL(Nodo* nodo){
+    nodo->izquierda = rotacionIzquierdaAVL(nodo->izquierda);
+    return rotacionDerechaAVL(nodo);
+}
+
+template <class Nodo>
+Nodo* rotacionDerLuegoIzqAVL(Nodo* nodo){
+    nodo->derecha = rotacionDerechaAVL(nodo->derecha);
+    return rotacionIzquierdaAVL(nodo);
+}
+
+//Sube desde nodo hacia la raiz corrigiendo alturas y rotando donde haga falta. Es un loop sobre
+//los punteros padre (nada de recursion: con arboles de 40M de nodos la version recursiva volaba
+//la pila) y corta en el primer ancestro cuya altura no cambio, porque de ahi para arriba las
+//alturas cacheadas siguen validas. Devuelve la nueva raiz si llego hasta arriba, o nullptr si
+//corto antes (en ese caso la raiz no cambio y el que llama no tiene que tocar nada).
+template <class Nodo>
+Nodo* rebalancearAVL(Nodo* nodo){
+    while (nodo != nullptr){
+        int alturaAntes = nodo->altura;
+        definirBalanceoAVL(nodo);
+        if (nodo->balanceo == -2){
+            if (largoAVL(nodo->izquierda->izquierda) >= largoAVL(nodo->izquierda->derecha)){
+                AVL_CONTAR(rotacionesDerecha, 1);
+                nodo = rotacionDerechaAVL(nodo);
+            }
+            else {
+                AVL_CONTAR(rotacionesIzqLuegoDer, 1);
+                nodo = rotacionIzqLuegoDerAVL(nodo);
+            }
+        }
+        else if (nodo->balanceo == 2){
+            if (largoAVL(nodo->derecha->derecha) >= largoAVL(nodo->derecha->izquierda)){
+                AVL_CONTAR(rotacionesIzquierda, 1);
+                nodo = rotacionIzquierdaAVL(nodo);
+            }
+            else {
+                AVL_CONTAR(rotacionesDerLuegoIzq, 1);
+                nodo = rotacionDerLuegoIzqAVL(nodo);
+            }
+        }
+        if (nodo->padre == nullptr) return nodo;
+        if (nodo->altura == alturaAntes) return nullptr; //nada cambia mas arriba
+        nodo = nodo->padre;
+    }
+    return nullptr;
+}
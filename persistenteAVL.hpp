@@ -0,0 +1,354 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include "compactoAVL.hpp"
+
+//Modo persistente (copy-on-write): insertar() y borrar() no tocan el arbol viejo, copian solo
+//el camino raiz-hoja modificado (O(log n) nodos nuevos) y comparten todo lo demas. Con eso un
+//snapshot consistente es copiar el handle: O(1), un incremento de refcount sobre la raiz. El
+//workload 98% lectura toma un snapshot por segundo sin frenar el ingest; antes era una copia
+//stop-the-world de 3-4 segundos.
+//
+//Los nodos no tienen puntero padre (un subarbol compartido por N snapshots no puede tener un
+//unico padre), asi que se reusan los genericos de compactoAVL: mismas rotaciones por enlace y
+//mismo balanceo/altura en un byte. La vida de cada nodo la lleva un refcount atomico intrusivo:
+//cuando la ultima raiz que lo alcanzaba se suelta, cae el con todo lo que solo el referenciaba.
+//Nada de arena aca: los bloques compartidos entre snapshots no se pueden liberar de a bloques.
+//
+//Concurrencia: un escritor muta su handle y los lectores navegan los suyos sin ningun lock; lo
+//unico que necesita exclusion (un mutex cortito, estilo concurrenteAVL) es el instante de
+//copiar el handle del escritor, porque el puntero raiz cambia en cada escritura.
+
+template <class Clave, class Definicion = void>
+class NodoAVLPersistente {
+public:
+    NodoAVLPersistente *izquierda, *derecha;
+    Clave clave;
+    Definicion definicion;
+    std::atomic<unsigned> refs;
+    std::int8_t balanceo;
+    std::int8_t altura;
+    NodoAVLPersistente(Clave clave, Definicion definicion) : izquierda(nullptr), derecha(nullptr), clave(std::move(clave)), definicion(std::move(definicion)), refs(1), balanceo(0), altura(0) {}
+};
+
+template <class Clave>
+class NodoAVLPersistente<Clave, void> {
+public:
+    NodoAVLPersistente *izquierda, *derecha;
+    Clave clave;
+    std::atomic<unsigned> refs;
+    std::int8_t balanceo;
+    std::int8_t altura;
+    explicit NodoAVLPersistente(Clave clave) : izquierda(nullptr), derecha(nullptr), clave(std::move(clave)), refs(1), balanceo(0), altura(0) {}
+};
+
+template <class Nodo>
+void retenerPersistente(Nodo* nodo){
+    if (nodo != nullptr) nodo->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+//Suelta una referencia; si era la ultima borra el nodo y suelta las de sus hijos. El hijo
+//derecho sigue en el loop y el izquierdo recursiona: la profundidad queda acotada por la
+//altura del arbol, que en un AVL no pasa de ~96 niveles.
+template <class Nodo>
+void soltarPersistente(Nodo* nodo){
+    while (nodo != nullptr && nodo->refs.fetch_sub(1, std::memory_order_acq_rel) == 1){
+        Nodo* izquierda = nodo->izquierda;
+        Nodo* derecha = nodo->derecha;
+        delete nodo;
+        soltarPersistente(izquierda);
+        nodo = derecha;
+    }
+}
+
+//Copia el nodo (carga y balanceo/altura cacheados) reteniendo a sus dos hijos: el clon y el
+//original comparten los subarboles hasta que alguien los haga unicos.
+template <class Clave, class Definicion>
+NodoAVLPersistente<Clave, Definicion>* clonPersistente(const NodoAVLPersistente<Clave, Definicion>* origen){
+    NodoAVLPersistente<Clave, Definicion>* copia = new NodoAVLPersistente<Clave, Definicion>(origen->clave, origen->definicion);
+    copia->izquierda = origen->izquierda;
+    copia->derecha = origen->derecha;
+    copia->balanceo = origen->balanceo;
+    copia->altura = origen->altura;
+    retenerPersistente(copia->izquierda);
+    retenerPersistente(copia->derecha);
+    return copia;
+}
+
+template <class Clave>
+NodoAVLPersistente<Clave, void>* clonPersistente(const NodoAVLPersistente<Clave, void>* origen){
+    NodoAVLPersistente<Clave, void>* copia = new NodoAVLPersistente<Clave, void>(origen->clave);
+    copia->izquierda = origen->izquierda;
+    copia->derecha = origen->derecha;
+    copia->balanceo = origen->balanceo;
+    copia->altura = origen->altura;
+    retenerPersistente(copia->izquierda);
+    retenerPersistente(copia->derecha);
+    return copia;
+}
+
+//El copy-on-write propiamente dicho: si el enlace apunta a un nodo compartido lo reemplaza por
+//un clon propio. Con refs == 1 no hay nada que copiar (y el chequeo es seguro: mientras tengamos
+//la unica referencia nadie mas puede fabricar otra). Los nodos recien copiados del camino ya
+//nacen con refs == 1, asi que las rotaciones de un mismo rebalanceo no copian dos veces.
+template <class Nodo>
+void hacerUnicoPersistente(Nodo*& enlace){
+    if (enlace->refs.load(std::memory_order_acquire) == 1) return;
+    Nodo* copia = clonPersistente(enlace);
+    soltarPersistente(enlace);
+    enlace = copia;
+}
+
+//Rebalanceo de un nivel al desandar la recursion. enlace ya es un nodo propio del camino nuevo;
+//las rotaciones de compactoAVL mutan al pivote y a su hijo, asi que el hijo se hace unico antes.
+template <class Nodo>
+void rebalancearPersistente(Nodo*& enlace){
+    definirBalanceoCompacto(enlace);
+    if (enlace->balanceo == -2){
+        hacerUnicoPersistente(enlace->izquierda);
+        if (largoCompacto(enlace->izquierda->izquierda) >= largoCompacto(enlace->izquierda->derecha))
+            rotacionDerechaCompacta(enlace);
+        else {
+            hacerUnicoPersistente(enlace->izquierda->derecha);
+            rotacionIzquierdaCompacta(enlace->izquierda);
+            rotacionDerechaCompacta(enlace);
+        }
+    }
+    else if (enlace->balanceo == 2){
+        hacerUnicoPersistente(enlace->derecha);
+        if (largoCompacto(enlace->derecha->derecha) >= largoCompacto(enlace->derecha->izquierda))
+            rotacionIzquierdaCompacta(enlace);
+        else {
+            hacerUnicoPersistente(enlace->derecha->izquierda);
+            rotacionDerechaCompacta(enlace->derecha);
+            rotacionIzquierdaCompacta(enlace);
+        }
+    }
+}
+
+//Insercion por copia de camino: devuelve la raiz del subarbol nuevo (solo el camino es nuevo,
+//el resto se comparte), o nullptr si la clave ya estaba y no hay nada que copiar.
+template <class Nodo, class Clave, class... Args>
+Nodo* insertarPersistente(Nodo* nodo, const Clave& clave, Args&&... args){
+    if (nodo == nullptr) return new Nodo(clave, std::forward<Args>(args)...);
+    Nodo* hijo;
+    if (clave < nodo->clave)
+        hijo = insertarPersistente(nodo->izquierda, clave, std::forward<Args>(args)...);
+    else if (nodo->clave < clave)
+        hijo = insertarPersistente(nodo->derecha, clave, std::forward<Args>(args)...);
+    else
+        return nullptr;
+    if (hijo == nullptr) return nullptr;
+    Nodo* copia = clonPersistente(nodo);
+    if (clave < nodo->clave){
+        soltarPersistente(copia->izquierda);
+        copia->izquierda = hijo;
+    }
+    else {
+        soltarPersistente(copia->derecha);
+        copia->derecha = hijo;
+    }
+    rebalancearPersistente(copia);
+    return copia;
+}
+
+//Saca el maximo de un subarbol copiando el camino hasta el; deja en maximo el nodo original
+//(sigue vivo, lo sostiene el arbol viejo) para que el borrado le copie la carga.
+template <class Nodo>
+Nodo* quitarMaximoPersistente(Nodo* nodo, Nodo*& maximo){
+    if (nodo->derecha == nullptr){
+        maximo = nodo;
+        retenerPersistente(nodo->izquierda);
+        return nodo->izquierda;
+    }
+    Nodo* derecha = quitarMaximoPersistente(nodo->derecha, maximo);
+    Nodo* copia = clonPersistente(nodo);
+    soltarPersistente(copia->derecha);
+    copia->derecha = derecha;
+    rebalancearPersistente(copia);
+    return copia;
+}
+
+//Borrado por copia de camino. Devuelve la raiz nueva del subarbol (puede ser nullptr si quedo
+//vacio); borrado avisa si la clave estaba, porque si no estaba no se copio nada.
+template <class Nodo, class Clave>
+Nodo* borrarPersistente(Nodo* nodo, const Clave& clave, bool& borrado){
+    if (nodo == nullptr) return nullptr; //borrado queda en false
+    Nodo* copia;
+    if (clave < nodo->clave){
+        Nodo* hijo = borrarPersistente(nodo->izquierda, clave, borrado);
+        if (!borrado) return nullptr;
+        copia = clonPersistente(nodo);
+        soltarPersistente(copia->izquierda);
+        copia->izquierda = hijo;
+    }
+    else if (nodo->clave < clave){
+        Nodo* hijo = borrarPersistente(nodo->derecha, clave, borrado);
+        if (!borrado) return nullptr;
+        copia = clonPersistente(nodo);
+        soltarPersistente(copia->derecha);
+        copia->derecha = hijo;
+    }
+    else {
+        borrado = true;
+        if (nodo->izquierda == nullptr || nodo->derecha == nullptr){
+            //Cero o un hijo: el reemplazo es el subarbol del hijo tal cual, compartido
+            Nodo* hijo = nodo->izquierda != nullptr ? nodo->izquierda : nodo->derecha;
+            retenerPersistente(hijo);
+            return hijo;
+        }
+        //Dos hijos: el reemplazo es el predecesor (como en el motor comun), clonado con el
+        //subarbol izquierdo ya sin su maximo y el derecho compartido
+        Nodo* predecesor = nullptr;
+        Nodo* izquierda = quitarMaximoPersistente(nodo->izquierda, predecesor);
+        copia = clonPersistente(predecesor);
+        soltarPersistente(copia->izquierda);
+        soltarPersistente(copia->derecha);
+        copia->izquierda = izquierda;
+        retenerPersistente(nodo->derecha);
+        copia->derecha = nodo->derecha;
+    }
+    rebalancearPersistente(copia);
+    return copia;
+}
+
+//Cada handle es un snapshot: copiarlo es retener la raiz (O(1)) y cada uno ve para siempre la
+//version del momento de la copia. Las escrituras solo mueven la raiz del handle escrito.
+template <class T>
+class ConjuntoAVLPersistente {
+public:
+    ConjuntoAVLPersistente() : _raiz(nullptr), _cardinal(0) {}
+    ConjuntoAVLPersistente(const ConjuntoAVLPersistente& otro) : _raiz(otro._raiz), _cardinal(otro._cardinal) {
+        retenerPersistente(_raiz);
+    }
+    ConjuntoAVLPersistente(ConjuntoAVLPersistente&& otro) noexcept : _raiz(otro._raiz), _cardinal(otro._cardinal) {
+        otro._raiz = nullptr;
+        otro._cardinal = 0;
+    }
+    ConjuntoAVLPersistente& operator=(ConjuntoAVLPersistente otro) noexcept {
+        std::swap(_raiz, otro._raiz);
+        std::swap(_cardinal, otro._cardinal);
+        return *this;
+    }
+    ~ConjuntoAVLPersistente(){ soltarPersistente(_raiz); }
+    unsigned int cardinal() const { return _cardinal; }
+    bool pertenece(const T& clave) const { return buscarCompacto(_raiz, clave) != nullptr; }
+    void insertar(const T& clave){
+        Nodo* nueva = insertarPersistente(_raiz, clave);
+        if (nueva != nullptr){
+            soltarPersistente(_raiz);
+            _raiz = nueva;
+            _cardinal++;
+        }
+    }
+    void borrar(const T& clave){
+        bool borrado = false;
+        Nodo* nueva = borrarPersistente(_raiz, clave, borrado);
+        if (borrado){
+            soltarPersistente(_raiz);
+            _raiz = nueva;
+            _cardinal--;
+        }
+    }
+    //Pre: cardinal() > 0
+    const T& minimo() const {
+        Nodo* nodo = _raiz;
+        while (nodo->izquierda != nullptr) nodo = nodo->izquierda;
+        return nodo->clave;
+    }
+    const T& maximo() const {
+        Nodo* nodo = _raiz;
+        while (nodo->derecha != nullptr) nodo = nodo->derecha;
+        return nodo->clave;
+    }
+    //In-orden recursivo (sin punteros padre no hay siguienteAVL); la profundidad es la altura
+    template <class Visita>
+    void porOrden(Visita&& visita) const { porOrdenDesde(_raiz, visita); }
+private:
+    typedef NodoAVLPersistente<T> Nodo;
+    Nodo* _raiz;
+    unsigned int _cardinal;
+    template <class Visita>
+    static void porOrdenDesde(Nodo* nodo, Visita& visita){
+        if (nodo == nullptr) return;
+        porOrdenDesde(nodo->izquierda, visita);
+        visita(nodo->clave);
+        porOrdenDesde(nodo->derecha, visita);
+    }
+};
+
+template <class K, class V = K>
+class DiccionarioAVLPersistente {
+public:
+    DiccionarioAVLPersistente() : _raiz(nullptr), _cardinal(0) {}
+    DiccionarioAVLPersistente(const DiccionarioAVLPersistente& otro) : _raiz(otro._raiz), _cardinal(otro._cardinal) {
+        retenerPersistente(_raiz);
+    }
+    DiccionarioAVLPersistente(DiccionarioAVLPersistente&& otro) noexcept : _raiz(otro._raiz), _cardinal(otro._cardinal) {
+        otro._raiz = nullptr;
+        otro._cardinal = 0;
+    }
+    DiccionarioAVLPersistente& operator=(DiccionarioAVLPersistente otro) noexcept {
+        std::swap(_raiz, otro._raiz);
+        std::swap(_cardinal, otro._cardinal);
+        return *this;
+    }
+    ~DiccionarioAVLPersistente(){ soltarPersistente(_raiz); }
+    unsigned int cardinal() const { return _cardinal; }
+    bool definido(const K& clave) const { return buscarCompacto(_raiz, clave) != nullptr; }
+    //Pre: la clave esta definida
+    const V& obtener(const K& clave) const { return buscarCompacto(_raiz, clave)->definicion; }
+    void definir(const K& clave, const V& definicion){
+        Nodo* nueva = insertarPersistente(_raiz, clave, definicion);
+        if (nueva != nullptr){
+            soltarPersistente(_raiz);
+            _raiz = nueva;
+            _cardinal++;
+            return;
+        }
+        //Ya estaba: pisar la definicion tambien es copia de camino, los snapshots viejos
+        //siguen viendo el valor viejo
+        nueva = redefinir(_raiz, clave, definicion);
+        soltarPersistente(_raiz);
+        _raiz = nueva;
+    }
+    void borrar(const K& clave){
+        bool borrado = false;
+        Nodo* nueva = borrarPersistente(_raiz, clave, borrado);
+        if (borrado){
+            soltarPersistente(_raiz);
+            _raiz = nueva;
+            _cardinal--;
+        }
+    }
+    //In-orden recursivo con visita(clave, definicion)
+    template <class Visita>
+    void porOrden(Visita&& visita) const { porOrdenDesde(_raiz, visita); }
+private:
+    typedef NodoAVLPersistente<K, V> Nodo;
+    Nodo* _raiz;
+    unsigned int _cardinal;
+    //Copia el camino hasta la clave y le pisa la definicion; la forma del arbol no cambia,
+    //asi que no hay rebalanceo. Pre: la clave esta.
+    static Nodo* redefinir(Nodo* nodo, const K& clave, const V& definicion){
+        Nodo* copia = clonPersistente(nodo);
+        if (clave < nodo->clave){
+            soltarPersistente(copia->izquierda);
+            copia->izquierda = redefinir(nodo->izquierda, clave, definicion);
+        }
+        else if (nodo->clave < clave){
+            soltarPersistente(copia->derecha);
+            copia->derecha = redefinir(nodo->derecha, clave, definicion);
+        }
+        else copia->definicion = definicion;
+        return copia;
+    }
+    template <class Visita>
+    static void porOrdenDesde(Nodo* nodo, Visita& visita){
+        if (nodo == nullptr) return;
+        porOrdenDesde(nodo->izquierda, visita);
+        visita(nodo->clave, nodo->definicion);
+        porOrdenDesde(nodo->derecha, visita);
+    }
+};
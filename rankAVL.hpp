@@ -0,0 +1,49 @@
+#pragma once
+#include "conjuntoAVL.hpp"
+
+//Conjunto con estadisticas de orden: cada nodo guarda el tamano de su subarbol (cuenta) y con
+//eso rango() y nesimo() salen en O(log n) bajando una sola vez, en vez de recorrer en in-orden.
+//El mantenimiento de las cuentas vive en el nucleo (ver TieneCuentaAVL en nucleoAVL.hpp): el
+//conjunto comun usa NodoAVL pelado y no paga ni los 8 bytes ni las actualizaciones.
+
+template <class T>
+class NodoAVLCuenta {
+public:
+    T clave;
+    int balanceo;
+    int altura;
+    std::size_t cuenta; //Cantidad de nodos del subarbol enraizado aca (incluyendose)
+    NodoAVLCuenta *izquierda, *derecha, *padre;
+    NodoAVLCuenta(T clave, NodoAVLCuenta *p) : clave(std::move(clave)), balanceo(0), altura(0), cuenta(1), padre(p), izquierda(nullptr), derecha(nullptr) {}
+};
+
+template <class T>
+class ConjuntoAVLRank : public ConjuntoAVL<T, NodoAVLCuenta<T>> {
+public:
+    //Cantidad de claves del conjunto estrictamente menores que clave (la clave puede no estar).
+    std::size_t rango(const T& clave) const {
+        std::size_t menores = 0;
+        for (NodoAVLCuenta<T>* nodo = this->_raiz; nodo != nullptr;){
+            if (clave < nodo->clave) nodo = nodo->izquierda;
+            else if (nodo->clave < clave){
+                menores += cuentaAVL(nodo->izquierda) + 1;
+                nodo = nodo->derecha;
+            }
+            else return menores + cuentaAVL(nodo->izquierda);
+        }
+        return menores;
+    }
+    //Pre: k < cardinal(). Devuelve la k-esima clave mas chica (k arranca en 0, o sea nesimo(0) == minimo()).
+    const T& nesimo(std::size_t k) const {
+        NodoAVLCuenta<T>* nodo = this->_raiz;
+        while (true){
+            std::size_t izquierdos = cuentaAVL(nodo->izquierda);
+            if (k < izquierdos) nodo = nodo->izquierda;
+            else if (k == izquierdos) return nodo->clave;
+            else {
+                k -= izquierdos + 1;
+                nodo = nodo->derecha;
+            }
+        }
+    }
+};
@@ -0,0 +1,215 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "conjuntoAVL.hpp"
+#include "diccAVL.hpp"
+
+//Persistencia binaria de los arboles: el formato es deliberadamente plano (cabecera + claves
+//ordenadas + definiciones si las hay, sin punteros ni offsets), asi cargar es o bien un
+//construirBalanceado en O(n) o directamente servir busquedas contra el archivo mapeado con mmap
+//sin materializar ni un NodoAVL. Solo sirve para claves/definiciones trivially copyable; para
+//tipos con punteros adentro (string, etc.) haria falta otro formato.
+
+struct CabeceraSnapshotAVL {
+    char magia[4]; //"AVLs"
+    std::uint32_t version; //2: la columna de definiciones arranca alineada a 16 bytes
+    std::uint32_t tamanoClave;
+    std::uint32_t tamanoDefinicion; //0 para conjuntos
+    std::uint32_t relleno;
+    std::uint64_t cantidad;
+};
+
+inline void iniciarCabeceraSnapshotAVL(CabeceraSnapshotAVL& cabecera, std::uint32_t tamanoClave,
+                                       std::uint32_t tamanoDefinicion, std::uint64_t cantidad){
+    std::memcpy(cabecera.magia, "AVLs", 4);
+    cabecera.version = 2;
+    cabecera.tamanoClave = tamanoClave;
+    cabecera.tamanoDefinicion = tamanoDefinicion;
+    cabecera.relleno = 0;
+    cabecera.cantidad = cantidad;
+}
+
+inline bool cabeceraSnapshotValida(const CabeceraSnapshotAVL& cabecera, std::uint32_t tamanoClave,
+                                   std::uint32_t tamanoDefinicion){
+    return std::memcmp(cabecera.magia, "AVLs", 4) == 0 && cabecera.version == 2 &&
+           cabecera.tamanoClave == tamanoClave && cabecera.tamanoDefinicion == tamanoDefinicion;
+}
+
+//Relleno entre la columna de claves y la de definiciones para que esta ultima quede en un
+//offset multiplo de 16 (la alineacion fundamental maxima): la vista mapeada referencia las
+//definiciones en el lugar, y sin esto quedaban desalineadas en cuanto cantidad*tamanoClave no
+//era multiplo de alignof(V). 16 cubre cualquier tipo trivially copyable sin que los escritores
+//con tamano borrado (guardarOrdenado) tengan que conocer el alignof exacto.
+inline std::size_t rellenoDefinicionesSnapshotAVL(std::uint64_t cantidad, std::uint32_t tamanoClave){
+    std::size_t fin = sizeof(CabeceraSnapshotAVL) + static_cast<std::size_t>(cantidad) * tamanoClave;
+    return (16 - fin % 16) % 16;
+}
+
+template <class T>
+bool guardarAVL(const ConjuntoAVL<T>& conjunto, const char* ruta){
+    static_assert(std::is_trivially_copyable<T>::value, "el snapshot binario necesita claves trivially copyable");
+    std::FILE* archivo = std::fopen(ruta, "wb");
+    if (archivo == nullptr) return false;
+    CabeceraSnapshotAVL cabecera;
+    iniciarCabeceraSnapshotAVL(cabecera, sizeof(T), 0, conjunto.cardinal());
+    bool ok = std::fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1;
+    for (typename ConjuntoAVL<T>::const_iterator it = conjunto.begin(); ok && it != conjunto.end(); ++it)
+        ok = std::fwrite(&*it, sizeof(T), 1, archivo) == 1;
+    return (std::fclose(archivo) == 0) && ok;
+}
+
+template <class K, class V>
+bool guardarAVL(const DiccionarioAVL<K, V>& dicc, const char* ruta){
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "el snapshot binario necesita claves y definiciones trivially copyable");
+    std::FILE* archivo = std::fopen(ruta, "wb");
+    if (archivo == nullptr) return false;
+    CabeceraSnapshotAVL cabecera;
+    iniciarCabeceraSnapshotAVL(cabecera, sizeof(K), sizeof(V), dicc.cardinal());
+    bool ok = std::fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1;
+    //Claves y definiciones en columnas separadas: la vista mapeada busca tocando solo las claves
+    for (typename DiccionarioAVL<K, V>::const_iterator it = dicc.begin(); ok && it != dicc.end(); ++it)
+        ok = std::fwrite(&it.clave(), sizeof(K), 1, archivo) == 1;
+    const unsigned char ceros[16] = {};
+    std::size_t relleno = rellenoDefinicionesSnapshotAVL(cabecera.cantidad, sizeof(K));
+    ok = ok && (relleno == 0 || std::fwrite(ceros, 1, relleno, archivo) == relleno);
+    for (typename DiccionarioAVL<K, V>::const_iterator it = dicc.begin(); ok && it != dicc.end(); ++it)
+        ok = std::fwrite(&it.definicion(), sizeof(V), 1, archivo) == 1;
+    return (std::fclose(archivo) == 0) && ok;
+}
+
+//Cargan el snapshot materializando el arbol via la carga masiva O(n). Si algo falla devuelven
+//un arbol vacio; los que necesiten arrancar sin materializar nada usan las vistas mapeadas de abajo.
+template <class T>
+ConjuntoAVL<T> cargarConjuntoAVL(const char* ruta){
+    static_assert(std::is_trivially_copyable<T>::value, "el snapshot binario necesita claves trivially copyable");
+    std::FILE* archivo = std::fopen(ruta, "rb");
+    if (archivo == nullptr) return ConjuntoAVL<T>();
+    CabeceraSnapshotAVL cabecera;
+    if (std::fread(&cabecera, sizeof(cabecera), 1, archivo) != 1 || !cabeceraSnapshotValida(cabecera, sizeof(T), 0)){
+        std::fclose(archivo);
+        return ConjuntoAVL<T>();
+    }
+    std::vector<T> claves(cabecera.cantidad);
+    bool ok = cabecera.cantidad == 0 || std::fread(claves.data(), sizeof(T), claves.size(), archivo) == claves.size();
+    std::fclose(archivo);
+    if (!ok) return ConjuntoAVL<T>();
+    return ConjuntoAVL<T>(claves.data(), claves.size());
+}
+
+template <class K, class V = K>
+DiccionarioAVL<K, V> cargarDiccAVL(const char* ruta){
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "el snapshot binario necesita claves y definiciones trivially copyable");
+    std::FILE* archivo = std::fopen(ruta, "rb");
+    if (archivo == nullptr) return DiccionarioAVL<K, V>();
+    CabeceraSnapshotAVL cabecera;
+    if (std::fread(&cabecera, sizeof(cabecera), 1, archivo) != 1 || !cabeceraSnapshotValida(cabecera, sizeof(K), sizeof(V))){
+        std::fclose(archivo);
+        return DiccionarioAVL<K, V>();
+    }
+    std::vector<K> claves(cabecera.cantidad);
+    std::vector<V> definiciones(cabecera.cantidad);
+    std::size_t relleno = rellenoDefinicionesSnapshotAVL(cabecera.cantidad, sizeof(K));
+    bool ok = cabecera.cantidad == 0 ||
+              (std::fread(claves.data(), sizeof(K), claves.size(), archivo) == claves.size() &&
+               std::fseek(archivo, static_cast<long>(relleno), SEEK_CUR) == 0 &&
+               std::fread(definiciones.data(), sizeof(V), definiciones.size(), archivo) == definiciones.size());
+    std::fclose(archivo);
+    if (!ok) return DiccionarioAVL<K, V>();
+    return DiccionarioAVL<K, V>(claves.data(), definiciones.data(), claves.size());
+}
+
+//Vista de solo lectura directamente sobre el archivo mapeado: cero copias, arranque instantaneo
+//y varias instancias/procesos comparten las mismas paginas fisicas via page cache. Las busquedas
+//son binarias sobre el arreglo ordenado de claves.
+template <class T>
+class VistaConjuntoMapeado {
+public:
+    explicit VistaConjuntoMapeado(const char* ruta) : _mapa(nullptr), _largoMapa(0), _claves(nullptr), _cantidad(0) {
+        static_assert(std::is_trivially_copyable<T>::value, "el snapshot binario necesita claves trivially copyable");
+        abrir(ruta, 0);
+    }
+    ~VistaConjuntoMapeado(){
+        if (_mapa != nullptr) munmap(_mapa, _largoMapa);
+    }
+    VistaConjuntoMapeado(const VistaConjuntoMapeado&) = delete;
+    VistaConjuntoMapeado& operator=(const VistaConjuntoMapeado&) = delete;
+    bool valida() const { return _mapa != nullptr; }
+    std::size_t cardinal() const { return _cantidad; }
+    bool pertenece(const T& clave) const {
+        std::size_t desde = 0, hasta = _cantidad;
+        while (desde < hasta){
+            std::size_t medio = desde + (hasta - desde) / 2;
+            if (_claves[medio] < clave) desde = medio + 1;
+            else hasta = medio;
+        }
+        return desde < _cantidad && !(clave < _claves[desde]) && !(_claves[desde] < clave);
+    }
+    //Pre: cardinal() > 0
+    const T& minimo() const { return _claves[0]; }
+    const T& maximo() const { return _claves[_cantidad - 1]; }
+    const T* claves() const { return _claves; }
+
+protected:
+    void* _mapa;
+    std::size_t _largoMapa;
+    const T* _claves;
+    std::size_t _cantidad;
+    void abrir(const char* ruta, std::uint32_t tamanoDefinicion){
+        int fd = open(ruta, O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(CabeceraSnapshotAVL)){
+            close(fd);
+            return;
+        }
+        void* mapa = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); //el mapeo sobrevive al descriptor
+        if (mapa == MAP_FAILED) return;
+        const CabeceraSnapshotAVL* cabecera = static_cast<const CabeceraSnapshotAVL*>(mapa);
+        std::size_t esperado = sizeof(CabeceraSnapshotAVL) + cabecera->cantidad * (sizeof(T) + tamanoDefinicion);
+        if (tamanoDefinicion != 0) esperado += rellenoDefinicionesSnapshotAVL(cabecera->cantidad, sizeof(T));
+        if (!cabeceraSnapshotValida(*cabecera, sizeof(T), tamanoDefinicion) || static_cast<std::size_t>(st.st_size) < esperado){
+            munmap(mapa, st.st_size);
+            return;
+        }
+        _mapa = mapa;
+        _largoMapa = st.st_size;
+        _claves = reinterpret_cast<const T*>(static_cast<const unsigned char*>(mapa) + sizeof(CabeceraSnapshotAVL));
+        _cantidad = cabecera->cantidad;
+    }
+    VistaConjuntoMapeado() : _mapa(nullptr), _largoMapa(0), _claves(nullptr), _cantidad(0) {}
+};
+
+template <class K, class V = K>
+class VistaDiccMapeado : public VistaConjuntoMapeado<K> {
+public:
+    explicit VistaDiccMapeado(const char* ruta) {
+        static_assert(std::is_trivially_copyable<V>::value, "el snapshot binario necesita definiciones trivially copyable");
+        this->abrir(ruta, sizeof(V));
+        if (this->_mapa != nullptr)
+            _definiciones = reinterpret_cast<const V*>(
+                reinterpret_cast<const unsigned char*>(this->_claves + this->_cantidad) +
+                rellenoDefinicionesSnapshotAVL(this->_cantidad, sizeof(K)));
+    }
+    bool definido(const K& clave) const { return this->pertenece(clave); }
+    //Pre: la clave esta definida
+    const V& obtener(const K& clave) const {
+        std::size_t desde = 0, hasta = this->_cantidad;
+        while (desde < hasta){
+            std::size_t medio = desde + (hasta - desde) / 2;
+            if (this->_claves[medio] < clave) desde = medio + 1;
+            else hasta = medio;
+        }
+        return _definiciones[desde];
+    }
+private:
+    const V* _definiciones;
+};
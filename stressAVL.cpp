@@ -0,0 +1,160 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+#include "conjuntoAVL.hpp"
+
+//Stress/fuzz de ConjuntoAVL contra un std::set oraculo: millones de insertar/borrar/pertenece
+//al azar, validando cada tantas operaciones los invariantes completos (verificarAVL: orden,
+//alturas, balanceo en [-1,1], punteros padre, _cardinal) y ademas que la altura no pase de
+//1.44*log2(n) — asi una degradacion gradual del balanceo revienta aca y no a las semanas en
+//produccion (como paso con el rebalanceo de borrar()).
+//
+//Si algo falla, minimiza la traza (sacando tandas de operaciones mientras siga fallando) y la
+//vuelca a un archivo replayable, para debuggear con la secuencia mas corta que reproduce.
+//
+//Uso:  stressAVL [ops] [semilla] [rangoClaves] [cadaCuanto]
+//      stressAVL --reproducir traza.txt
+//  - sin args: 2000000 de ops, semilla 1, claves en [0, 500000), chequeo cada 20000
+
+namespace {
+
+struct Operacion {
+    char tipo; //'i' insertar, 'b' borrar, 'p' pertenece
+    std::uint64_t clave;
+};
+
+//Limite teorico de altura AVL: h < 1.4405*log2(n+2) - 0.3277. Se chequea contra el techo
+//redondeado para no fallar por la constante en arboles chicos.
+bool alturaRazonable(int altura, std::size_t n){
+    if (n < 2) return altura <= static_cast<int>(n);
+    return altura <= static_cast<int>(1.4405 * std::log2(static_cast<double>(n) + 2.0) - 0.3277) + 1;
+}
+
+//Corre la traza entera contra el arbol y el oraculo; false apenas algo no cierra.
+//chequearCada == 1 valida despues de cada operacion (para las trazas minimizadas).
+bool correrTraza(const std::vector<Operacion>& traza, std::size_t chequearCada, std::size_t* dondeFallo){
+    ConjuntoAVL<std::uint64_t> arbol;
+    std::set<std::uint64_t> oraculo;
+    for (std::size_t i = 0; i < traza.size(); ++i){
+        const Operacion& op = traza[i];
+        if (op.tipo == 'i'){ arbol.insertar(op.clave); oraculo.insert(op.clave); }
+        else if (op.tipo == 'b'){ arbol.borrar(op.clave); oraculo.erase(op.clave); }
+        else if (arbol.pertenece(op.clave) != (oraculo.count(op.clave) > 0)){
+            if (dondeFallo != nullptr) *dondeFallo = i;
+            return false;
+        }
+        if ((i + 1) % chequearCada == 0 || i + 1 == traza.size()){
+            bool ok = arbol.verificarAVL() && arbol.cardinal() == oraculo.size();
+            if (ok){
+                int altura = -1;
+                arbol.porNiveles([&altura](std::uint64_t, int nivel){ if (nivel > altura) altura = nivel; });
+                ok = alturaRazonable(altura, arbol.cardinal());
+            }
+            if (ok && !oraculo.empty()){
+                //in-orden completo contra el oraculo, no solo membership puntual
+                std::vector<std::uint64_t> enOrden;
+                arbol.toVector(enOrden);
+                std::size_t j = 0;
+                for (std::uint64_t clave : oraculo)
+                    if (j >= enOrden.size() || enOrden[j++] != clave) { ok = false; break; }
+            }
+            if (!ok){
+                if (dondeFallo != nullptr) *dondeFallo = i;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//Minimizacion golosa: recorta la cola despues de la falla y despues intenta sacar tandas cada
+//vez mas chicas mientras la traza siga fallando. No es delta-debugging completo pero deja
+//trazas de millones en decenas de operaciones en un par de segundos.
+std::vector<Operacion> minimizarTraza(std::vector<Operacion> traza){
+    std::size_t dondeFallo = 0;
+    if (!correrTraza(traza, 1, &dondeFallo)) traza.resize(dondeFallo + 1);
+    for (std::size_t tanda = traza.size() / 2; tanda >= 1; tanda /= 2){
+        for (std::size_t desde = 0; desde + tanda <= traza.size(); ){
+            std::vector<Operacion> recortada;
+            recortada.reserve(traza.size() - tanda);
+            recortada.insert(recortada.end(), traza.begin(), traza.begin() + desde);
+            recortada.insert(recortada.end(), traza.begin() + desde + tanda, traza.end());
+            if (!correrTraza(recortada, 1, nullptr)) traza.swap(recortada); //sigue fallando: afuera la tanda
+            else desde += tanda;
+        }
+    }
+    return traza;
+}
+
+bool guardarTraza(const char* ruta, const std::vector<Operacion>& traza){
+    std::FILE* archivo = std::fopen(ruta, "w");
+    if (archivo == nullptr) return false;
+    for (const Operacion& op : traza)
+        std::fprintf(archivo, "%c %llu\n", op.tipo, static_cast<unsigned long long>(op.clave));
+    return std::fclose(archivo) == 0;
+}
+
+bool cargarTraza(const char* ruta, std::vector<Operacion>& traza){
+    std::FILE* archivo = std::fopen(ruta, "r");
+    if (archivo == nullptr) return false;
+    char tipo;
+    unsigned long long clave;
+    while (std::fscanf(archivo, " %c %llu", &tipo, &clave) == 2)
+        traza.push_back(Operacion{tipo, clave});
+    std::fclose(archivo);
+    return true;
+}
+
+} //namespace
+
+int main(int argc, char* argv[]){
+    if (argc == 3 && std::strcmp(argv[1], "--reproducir") == 0){
+        std::vector<Operacion> traza;
+        if (!cargarTraza(argv[2], traza)){
+            std::fprintf(stderr, "no pude leer %s\n", argv[2]);
+            return 2;
+        }
+        std::size_t dondeFallo = 0;
+        if (!correrTraza(traza, 1, &dondeFallo)){
+            std::printf("FALLA reproducida en la operacion %zu de %zu\n", dondeFallo, traza.size());
+            return 1;
+        }
+        std::printf("la traza de %zu operaciones ya no falla\n", traza.size());
+        return 0;
+    }
+
+    std::size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    std::uint64_t semilla = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1;
+    std::uint64_t rango = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 500000;
+    std::size_t cadaCuanto = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 20000;
+
+    //Mitad escrituras (insertar/borrar parejo, el churn de regimen) y mitad lecturas
+    std::mt19937_64 gen(semilla);
+    std::vector<Operacion> traza;
+    traza.reserve(ops);
+    for (std::size_t i = 0; i < ops; ++i){
+        std::uint64_t tirada = gen();
+        char tipo = (tirada & 3) == 0 ? 'b' : ((tirada & 3) == 1 ? 'i' : ((tirada & 1) ? 'p' : 'i'));
+        traza.push_back(Operacion{tipo, (tirada >> 8) % rango});
+    }
+
+    std::size_t dondeFallo = 0;
+    if (correrTraza(traza, cadaCuanto, &dondeFallo)){
+        std::printf("OK: %zu operaciones (semilla %llu, rango %llu), invariantes y altura dentro de 1.44*log2(n)\n",
+                    ops, static_cast<unsigned long long>(semilla), static_cast<unsigned long long>(rango));
+        return 0;
+    }
+
+    std::printf("FALLA cerca de la operacion %zu; minimizando...\n", dondeFallo);
+    std::vector<Operacion> minima = minimizarTraza(traza);
+    const char* ruta = "stressAVL-falla.txt";
+    guardarTraza(ruta, minima);
+    std::printf("traza minima de %zu operaciones en %s (reproducir con: stressAVL --reproducir %s)\n",
+                minima.size(), ruta, ruta);
+    return 1;
+}